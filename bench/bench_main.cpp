@@ -0,0 +1,306 @@
+#include "sonarlock/audio/fake_audio_backend.hpp"
+#include "sonarlock/audio/scenario_synth.hpp"
+#include "sonarlock/core/dsp_kernels.hpp"
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/dsp_primitives.hpp"
+#include "sonarlock/core/motion_detection.hpp"
+#include "sonarlock/core/sine_generator.hpp"
+#include "sonarlock/core/static_dsp_pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef SONARLOCK_VERSION
+#define SONARLOCK_VERSION "unknown"
+#endif
+#ifndef SONARLOCK_BUILD_TYPE
+#define SONARLOCK_BUILD_TYPE ""
+#endif
+
+using namespace sonarlock;
+
+namespace {
+
+struct Options {
+    bool json{false};
+    bool quick{false};
+    std::string out_path;
+    int reps{7};
+};
+
+struct KernelResult {
+    std::string name;
+    double ns_per_sample{0.0};
+};
+
+struct PipelineResult {
+    const char* variant{""};
+    std::size_t frames_per_buffer{0};
+    double ns_per_sample{0.0};
+    double realtime_factor{0.0};
+};
+
+struct ScenarioResult {
+    std::string name;
+    double realtime_factor{0.0};
+    std::uint64_t triggered{0};
+};
+
+// Keeps results observable so the timed loops are not optimised away.
+volatile double g_sink = 0.0;
+
+// Best of reps runs of fn(), each covering samples samples.
+template <typename Fn> double best_ns_per_sample(int reps, std::size_t samples, Fn&& fn) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < reps; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(samples));
+    }
+    return best;
+}
+
+std::vector<KernelResult> bench_kernels(const Options& opt) {
+    constexpr double kRate = 48000.0;
+    constexpr std::size_t kBlock = 4096;
+    const std::size_t n = opt.quick ? (1U << 15) : (1U << 20);
+    std::vector<KernelResult> out;
+
+    std::vector<double> c(kBlock);
+    std::vector<double> s(kBlock);
+    const std::pair<const char*, core::NcoMode> modes[] = {{"nco_direct_fill", core::NcoMode::Direct},
+                                                           {"nco_recurrence_fill", core::NcoMode::Recurrence},
+                                                           {"nco_lut_fill", core::NcoMode::Lut}};
+    for (const auto& [name, mode] : modes) {
+        core::Nco nco(kRate, 18000.0, mode);
+        out.push_back({name, best_ns_per_sample(opt.reps, n, [&] {
+                           for (std::size_t k = 0; k < n; k += kBlock) nco.fill(c, s);
+                           g_sink = c[kBlock - 1] + s[kBlock - 1];
+                       })});
+    }
+    {
+        core::Nco nco(kRate, 18000.0);
+        out.push_back({"nco_next", best_ns_per_sample(opt.reps, n, [&] {
+                           double acc = 0.0;
+                           for (std::size_t k = 0; k < n; ++k) acc += nco.next().first;
+                           g_sink = acc;
+                       })});
+    }
+
+    std::vector<double> x(kBlock);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (auto& v : x) v = u(rng);
+    std::vector<double> y(kBlock);
+    {
+        core::IirLowPass lp(kRate, 400.0);
+        out.push_back({"iir_lowpass_process", best_ns_per_sample(opt.reps, n, [&] {
+                           double acc = 0.0;
+                           for (std::size_t k = 0; k < n; ++k) acc += lp.process(x[k % kBlock]);
+                           g_sink = acc;
+                       })});
+        out.push_back({"iir_lowpass_process_block", best_ns_per_sample(opt.reps, n, [&] {
+                           for (std::size_t k = 0; k < n; k += kBlock) lp.process_block(x, y);
+                           g_sink = y[kBlock - 1];
+                       })});
+    }
+    {
+        core::PhaseTracker tracker;
+        out.push_back({"phase_tracker_unwrap", best_ns_per_sample(opt.reps, n, [&] {
+                           double acc = 0.0;
+                           for (std::size_t k = 0; k < n; ++k) acc += tracker.unwrap(x[k % kBlock], x[(k + 1) % kBlock]);
+                           g_sink = acc;
+                       })});
+    }
+    {
+        core::SineGenerator gen(kRate, 18000.0);
+        std::vector<float> tone(512);
+        out.push_back({"sine_generator_generate", best_ns_per_sample(opt.reps, n, [&] {
+                           for (std::size_t k = 0; k < n; k += tone.size()) gen.generate(tone, n, k);
+                           g_sink = tone.back();
+                       })});
+    }
+    {
+        // Per call rather than per sample: the scorer runs once per feature update.
+        const core::DefaultMotionScorer scorer;
+        std::vector<core::MotionFeatures> features(256);
+        for (auto& f : features) {
+            f.baseband_energy = u(rng) + 1.0;
+            f.doppler_band_energy = u(rng) + 1.0;
+            f.phase_velocity = u(rng);
+            f.snr_estimate = 10.0 * (u(rng) + 1.0);
+            f.baseline_energy = 1.0;
+            f.relative_motion = u(rng) + 1.0;
+        }
+        out.push_back({"motion_scorer_score", best_ns_per_sample(opt.reps, n, [&] {
+                           double acc = 0.0;
+                           for (std::size_t k = 0; k < n; ++k) acc += scorer.score(features[k % features.size()]);
+                           g_sink = acc;
+                       })});
+    }
+    for (const auto& [name, scenario] : {std::pair{"scenario_synth_human", core::FakeScenario::Human},
+                                         std::pair{"scenario_synth_pet", core::FakeScenario::Pet}}) {
+        core::AudioConfig config;
+        audio::ScenarioSynth synth(config, scenario, 7, static_cast<double>(n) / config.audio.sample_rate_hz);
+        std::vector<float> block(n);
+        out.push_back({name, best_ns_per_sample(opt.reps, n, [&] {
+                           synth.render(0, block);
+                           g_sink = block[n - 1];
+                       })});
+    }
+    return out;
+}
+
+// BasicDspPipeline and the matching StaticDspPipeline on a fixed synthetic capture (tone + noise), one
+// session per block size.
+std::vector<PipelineResult> bench_pipeline(const Options& opt) {
+    core::AudioConfig config;
+    const double rate = config.audio.sample_rate_hz;
+    const auto frames = static_cast<std::size_t>(rate * (opt.quick ? 0.5 : 4.0));
+    std::vector<float> input(frames);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.01F, 0.01F);
+    for (std::size_t k = 0; k < frames; ++k) {
+        input[k] = static_cast<float>(0.25 * std::sin(6.28318530717958647692 * config.audio.f0_hz *
+                                                      static_cast<double>(k) / rate)) +
+                   noise(rng);
+    }
+
+    std::vector<PipelineResult> out;
+    core::BasicDspPipeline basic;
+    core::StaticDspPipeline<core::kStaticDspDefault> fixed;
+    for (const auto& [variant, pipeline] : {std::pair<const char*, core::IDspPipeline*>{"basic", &basic},
+                                            std::pair<const char*, core::IDspPipeline*>{"static", &fixed}}) {
+        for (std::size_t block = 32; block <= 4096; block *= 2) {
+            config.audio.frames_per_buffer = block;
+            std::vector<float> output(block);
+            const double ns = best_ns_per_sample(opt.reps, frames, [&] {
+                pipeline->begin_session(config);
+                for (std::size_t off = 0; off < frames; off += block) {
+                    const std::size_t n = std::min(block, frames - off);
+                    pipeline->process(std::span<const float>(input.data() + off, n), std::span<float>(output.data(), n), off);
+                }
+                g_sink = output[0];
+            });
+            out.push_back({variant, block, ns, ns > 0.0 ? 1e9 / (ns * rate) : 0.0});
+        }
+    }
+    return out;
+}
+
+// End to end through FakeAudioBackend, including input synthesis.
+std::vector<ScenarioResult> bench_scenarios(const Options& opt) {
+    const std::pair<const char*, core::FakeScenario> scenarios[] = {{"static", core::FakeScenario::Static},
+                                                                    {"human", core::FakeScenario::Human},
+                                                                    {"pet", core::FakeScenario::Pet},
+                                                                    {"vibration", core::FakeScenario::Vibration}};
+    std::vector<ScenarioResult> out;
+    core::BasicDspPipeline pipeline;
+    for (const auto& [name, scenario] : scenarios) {
+        core::AudioConfig config;
+        config.scenario = scenario;
+        config.audio.duration_seconds = opt.quick ? 1.0 : 12.0;
+        audio::FakeAudioBackend backend(scenario, config.seed);
+        ScenarioResult r{name, 0.0, 0};
+        for (int rep = 0; rep < std::max(1, opt.reps / 2); ++rep) {
+            core::RuntimeMetrics m;
+            if (!backend.run_session(config, pipeline, m, [] { return false; }).ok()) break;
+            r.realtime_factor = std::max(r.realtime_factor, m.realtime_factor);
+            r.triggered = m.triggered_count;
+        }
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::string to_json(const Options& opt, const std::vector<KernelResult>& kernels,
+                    const std::vector<PipelineResult>& pipeline, const std::vector<ScenarioResult>& scenarios) {
+    std::ostringstream ss;
+    ss.precision(6);
+    const std::string build_type = SONARLOCK_BUILD_TYPE;
+    ss << "{\n  \"version\": \"" << SONARLOCK_VERSION << "\",\n";
+    ss << "  \"build_type\": \"" << (build_type.empty() ? "unspecified" : build_type) << "\",\n";
+    ss << "  \"simd\": \"" << core::kernels::level_name(core::kernels::active_level()) << "\",\n";
+    ss << "  \"quick\": " << (opt.quick ? "true" : "false") << ",\n  \"reps\": " << opt.reps << ",\n";
+    ss << "  \"kernels\": [\n";
+    for (std::size_t i = 0; i < kernels.size(); ++i) {
+        ss << "    {\"name\": \"" << kernels[i].name << "\", \"ns_per_sample\": " << kernels[i].ns_per_sample << "}"
+           << (i + 1 < kernels.size() ? ",\n" : "\n");
+    }
+    ss << "  ],\n  \"pipeline\": [\n";
+    for (std::size_t i = 0; i < pipeline.size(); ++i) {
+        ss << "    {\"variant\": \"" << pipeline[i].variant << "\", \"frames_per_buffer\": " << pipeline[i].frames_per_buffer
+           << ", \"ns_per_sample\": " << pipeline[i].ns_per_sample
+           << ", \"realtime_factor\": " << pipeline[i].realtime_factor << "}" << (i + 1 < pipeline.size() ? ",\n" : "\n");
+    }
+    ss << "  ],\n  \"scenarios\": [\n";
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        ss << "    {\"scenario\": \"" << scenarios[i].name << "\", \"realtime_factor\": " << scenarios[i].realtime_factor
+           << ", \"triggered\": " << scenarios[i].triggered << "}" << (i + 1 < scenarios.size() ? ",\n" : "\n");
+    }
+    ss << "  ]\n}\n";
+    return ss.str();
+}
+
+void print_table(const std::vector<KernelResult>& kernels, const std::vector<PipelineResult>& pipeline,
+                 const std::vector<ScenarioResult>& scenarios) {
+    std::printf("%-28s %12s\n", "kernel", "ns/sample");
+    for (const auto& k : kernels) std::printf("%-28s %12.3f\n", k.name.c_str(), k.ns_per_sample);
+    std::printf("\n%-8s %19s %12s %12s\n", "pipeline", "frames_per_buffer", "ns/sample", "realtime");
+    for (const auto& p : pipeline) {
+        std::printf("%-8s %19zu %12.3f %11.1fx\n", p.variant, p.frames_per_buffer, p.ns_per_sample, p.realtime_factor);
+    }
+    std::printf("\n%-28s %12s %12s\n", "scenario", "realtime", "triggered");
+    for (const auto& s : scenarios) {
+        std::printf("%-28s %11.1fx %12llu\n", s.name.c_str(), s.realtime_factor,
+                    static_cast<unsigned long long>(s.triggered));
+    }
+}
+
+int usage() {
+    std::cerr << "usage: sonarlock_bench [--json] [--out path.json] [--quick] [--reps N]\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--json") opt.json = true;
+        else if (a == "--quick") opt.quick = true;
+        else if (a == "--out" && i + 1 < argc) opt.out_path = argv[++i];
+        else if (a == "--reps" && i + 1 < argc) opt.reps = std::max(1, std::atoi(argv[++i]));
+        else return usage();
+    }
+
+    const auto kernels = bench_kernels(opt);
+    const auto pipeline = bench_pipeline(opt);
+    const auto scenarios = bench_scenarios(opt);
+
+    const std::string json = to_json(opt, kernels, pipeline, scenarios);
+    if (opt.json) std::cout << json;
+    else print_table(kernels, pipeline, scenarios);
+    if (!opt.out_path.empty()) {
+        std::ofstream f(opt.out_path);
+        f << json;
+        if (!f) {
+            std::cerr << "cannot write " << opt.out_path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sonarlock/core/parameter_sweep.hpp"
 #include "sonarlock/core/types.hpp"
 
 #include <string>
@@ -7,7 +8,7 @@
 
 namespace sonarlock::app {
 
-enum class CommandKind { Devices, Run, Analyze, Calibrate, DumpEvents, Help };
+enum class CommandKind { Devices, Run, Analyze, Calibrate, DumpEvents, Replay, Help };
 
 struct CommandLine {
     CommandKind kind{CommandKind::Help};
@@ -17,6 +18,12 @@ struct CommandLine {
     std::string config_path;
     bool json_output{false};
     std::size_t dump_count{50};
+    std::string replay_path; // replay <trace>
+    // analyze --sweep: detection grid evaluated over one DSP pass per scenario/recording.
+    bool sweep{false};
+    core::SweepGrid sweep_grid;
+    double sweep_motion_start{-1.0}; // file input: known motion interval, seconds
+    double sweep_motion_end{-1.0};
 };
 
 core::Status parse_args(const std::vector<std::string>& args, CommandLine& out);
@@ -2,6 +2,8 @@
 
 #include "sonarlock/core/audio_backend.hpp"
 
+#include <utility>
+
 namespace sonarlock::audio {
 
 class FakeAudioBackend final : public core::IAudioBackend {
@@ -12,7 +14,13 @@ class FakeAudioBackend final : public core::IAudioBackend {
     core::Status run_session(const core::AudioConfig& config, core::IDspPipeline& pipeline,
                              core::RuntimeMetrics& out_metrics, const std::function<bool()>& should_stop) override;
 
+    // Seconds during which the scenario has someone moving (Human only), else {-1, -1}.
+    [[nodiscard]] static std::pair<double, double> motion_window(core::FakeScenario scenario, double run_seconds);
+
   private:
+    // Either the backend's or the session's scenario; Human wins over Pet over Vibration.
+    [[nodiscard]] core::FakeScenario effective_scenario(core::FakeScenario configured) const;
+
     core::FakeScenario scenario_;
     std::uint32_t seed_;
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "sonarlock/core/audio_backend.hpp"
+
+namespace sonarlock::audio {
+
+// Plays config.audio.input_path through the pipeline as fast as the CPU allows. The file is
+// memory-mapped; little-endian float32 data is handed to IDspPipeline::process as spans into the
+// mapping, PCM16/PCM24 is converted one frames_per_buffer block at a time. WAV files set the
+// session's sample rate and channel count; headerless files are read as interleaved float32 with
+// the configured ones. The whole file is processed (duration_seconds is ignored) in the same
+// blocks and frame offsets a live session would use, so detections match live processing.
+class FileAudioBackend final : public core::IAudioBackend {
+  public:
+    [[nodiscard]] std::vector<core::AudioDeviceInfo> enumerate_devices() const override;
+    core::Status run_session(const core::AudioConfig& config, core::IDspPipeline& pipeline,
+                             core::RuntimeMetrics& out_metrics, const std::function<bool()>& should_stop) override;
+};
+
+} // namespace sonarlock::audio
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "sonarlock/core/types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace sonarlock::audio {
+
+// Synthesises the fake scenarios' microphone input: the TX tone at f0 plus a scenario term (Human:
+// an f0 + 120 Hz echo inside the motion window; Pet: 7 Hz amplitude wobble and weak clutter;
+// Vibration: 8 Hz amplitude modulation) and uniform noise of +-0.01 per channel. Extra channels
+// hear the scene attenuated and phase-shifted with their own noise.
+//
+// Oscillators are complex phasors advanced by one multiply per sample and reset from exact sin/cos
+// at every kSegmentFrames boundary; noise comes from a counter-based hash of (seed, stream, frame).
+// A sample therefore depends only on the constructor arguments and its frame index: ranges can be
+// rendered in any order or split across threads (one instance each) with bit-identical output.
+class ScenarioSynth {
+  public:
+    static constexpr std::size_t kSegmentFrames = 4096;
+
+    ScenarioSynth(const core::AudioConfig& config, core::FakeScenario scenario, std::uint32_t seed, double run_seconds);
+
+    // Interleaved audio.input_channels samples for frames [first_frame, first_frame + out.size() / channels).
+    // Continuing from the previous call's end avoids resetting the oscillators mid-segment.
+    void render(std::size_t first_frame, std::span<float> out);
+
+    [[nodiscard]] std::size_t channels() const { return channels_; }
+
+  private:
+    struct Phasor {
+        double re{1.0};
+        double im{0.0};
+        double step_re{1.0};
+        double step_im{0.0};
+        double cycles_per_frame{0.0};
+
+        void seek(std::size_t frame);
+        void advance() {
+            const double r = re * step_re - im * step_im;
+            im = re * step_im + im * step_re;
+            re = r;
+        }
+    };
+
+    void seek(std::size_t frame);
+
+    core::FakeScenario scenario_;
+    std::size_t channels_{1};
+    std::array<std::uint64_t, core::kMaxInputChannels> noise_keys_{}; // one SplitMix64 stream per channel
+    std::uint64_t clutter_key_{0};
+    std::array<double, core::kMaxInputChannels> gain_{};
+    std::array<double, core::kMaxInputChannels> shift_cos_{};
+    std::array<double, core::kMaxInputChannels> shift_sin_{};
+    std::size_t gate_begin_{0}; // Human: frames in [gate_begin_, gate_end_) carry the echo
+    std::size_t gate_end_{0};
+    Phasor carrier_;
+    Phasor echo_;
+    Phasor wobble_; // Pet 7 Hz / Vibration 8 Hz amplitude modulation
+    std::size_t next_frame_{~std::size_t{0}};
+};
+
+} // namespace sonarlock::audio
@@ -2,8 +2,8 @@
 
 #include "sonarlock/core/types.hpp"
 
-#include <deque>
 #include <memory>
+#include <vector>
 
 namespace sonarlock::core {
 
@@ -26,7 +26,9 @@ class ActionSafetyController {
   private:
     DetectionSection cfg_;
     double lock_cooldown_until_{0.0};
-    std::deque<double> lock_times_;
+    std::vector<double> lock_times_; // ring of the last max_locks_per_minute lock times
+    std::size_t lock_head_{0};
+    std::size_t lock_count_{0};
 };
 
 } // namespace sonarlock::core
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sonarlock::core::alloc_audit {
+
+// Heap-allocation auditing for the audio callback. Active only in builds configured with
+// SONARLOCK_AUDIT_ALLOCATIONS=ON, which replace the global operator new (and malloc/calloc/
+// realloc on glibc) with counting wrappers. Otherwise every call here is a no-op.
+[[nodiscard]] bool enabled();
+
+// Allocations made on any thread while inside a CallbackScope since the last reset().
+[[nodiscard]] std::uint64_t callback_allocations();
+void reset();
+
+// Marks the current thread as running an audio callback for the lifetime of the scope.
+class CallbackScope {
+  public:
+    CallbackScope();
+    ~CallbackScope();
+    CallbackScope(const CallbackScope&) = delete;
+    CallbackScope& operator=(const CallbackScope&) = delete;
+};
+
+} // namespace sonarlock::core::alloc_audit
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/spsc_ring.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Decouples the audio callback from DSP. The callback only copies input into an SPSC ring and
+// pulls pre-rendered TX from a second ring; a worker thread runs IDspPipeline::process in
+// frames_per_buffer blocks. The caller runs pipeline.begin_session() before start().
+class AsyncDspRunner {
+  public:
+    static constexpr std::size_t kTxPrefillBlocks = 2;
+
+    AsyncDspRunner(IDspPipeline& pipeline, const AudioConfig& config);
+    ~AsyncDspRunner();
+    AsyncDspRunner(const AsyncDspRunner&) = delete;
+    AsyncDspRunner& operator=(const AsyncDspRunner&) = delete;
+
+    void start();
+    // Processes whatever input is still queued, then joins the worker.
+    void stop();
+
+    // Audio thread: never blocks or allocates. input is interleaved (see IDspPipeline::process).
+    // Drops input on overrun, pads output with silence on underrun. Drops are recorded at their RX
+    // position, so blocks captured after them are timestamped in device time and earlier ones are not.
+    void exchange(std::span<const float> input, std::span<float> output);
+    // Offline backends (no device clock): waits until exchange() of frames would neither drop input
+    // nor pad output, so a session runs at DSP speed and matches an inline one. Not for audio callbacks.
+    void wait_ready(std::size_t frames) const;
+
+    // Adds ring counters to metrics; call after stop().
+    void fill_metrics(RuntimeMetrics& metrics) const;
+
+  private:
+    struct DropMark {
+        std::size_t at{0}; // RX frame position of the dropped input
+        std::size_t frames{0};
+    };
+
+    void worker_loop();
+    // Worker: advances frame_offset_ over drops at or before RX frame position.
+    void apply_drops(std::size_t position);
+
+    IDspPipeline& pipeline_;
+    std::size_t block_frames_;
+    std::size_t channels_; // input is interleaved; TX is mono
+    std::chrono::microseconds idle_wait_;
+    SpscRing<float> rx_;
+    SpscRing<float> tx_;
+    SpscRing<DropMark> drops_;
+    std::vector<float> work_in_;
+    std::vector<float> work_out_;
+    DropMark held_{};            // audio thread: drop not yet in drops_
+    std::size_t rx_frames_{0};   // audio thread: frames pushed to rx_
+    DropMark next_drop_{};       // worker: popped from drops_, not yet applied
+    std::size_t read_frames_{0}; // worker: frames popped from rx_
+    std::size_t frame_offset_{0};
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> overruns_{0};
+    std::atomic<std::uint64_t> underruns_{0};
+    std::atomic<std::size_t> rx_high_water_{0};
+    std::atomic<std::size_t> tx_high_water_{0};
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "sonarlock/core/audio_backend.hpp"
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/event_journal.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace sonarlock::core {
+
+struct BatchResult {
+    Status status;
+    RuntimeMetrics metrics;
+    std::vector<JournalRecord> journal; // oldest first; empty if the pipeline keeps none
+};
+
+// Runs many independent sessions on a work-stealing pool. Each worker owns one pipeline that is
+// reused (begin_session resets it) so scratch buffers are only grown, never reallocated per job.
+// Jobs start as contiguous chunks per worker; an idle worker steals from the back of another
+// worker's queue. Sessions share no state, so results[i] equals a sequential run of jobs[i]
+// whatever the worker count or scheduling. Process-wide callback_allocations counts are not
+// meaningful while sessions overlap.
+class BatchEngine {
+  public:
+    using BackendFactory = std::function<std::unique_ptr<IAudioBackend>(const AudioConfig&)>;
+    using PipelineFactory = std::function<std::unique_ptr<IDspPipeline>()>;
+
+    // workers == 0 uses std::thread::hardware_concurrency(); a null pipeline factory makes
+    // BasicDspPipeline. Factories are called from worker threads.
+    explicit BatchEngine(BackendFactory backends, std::size_t workers = 0, PipelineFactory pipelines = {});
+    ~BatchEngine();
+    BatchEngine(const BatchEngine&) = delete;
+    BatchEngine& operator=(const BatchEngine&) = delete;
+
+    // Blocks until every job has run or cancel() was called. Jobs running at cancel() stop early and
+    // keep the metrics they reached; jobs not yet started get kErrCancelled. A cancel() issued before
+    // run() applies to that run; the flag clears when run() returns.
+    std::vector<BatchResult> run(std::span<const AudioConfig> jobs);
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::size_t workers() const { return queues_.size(); }
+    [[nodiscard]] std::uint64_t steals() const { return steals_.load(std::memory_order_relaxed); } // last run()
+
+  private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> jobs;
+    };
+
+    bool next_job(std::size_t worker, std::size_t& job);
+    void worker_loop(std::size_t worker, std::span<const AudioConfig> jobs, std::vector<BatchResult>& results);
+
+    BackendFactory backends_;
+    PipelineFactory pipelines_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::unique_ptr<IDspPipeline>> worker_pipelines_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<std::uint64_t> steals_{0};
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "sonarlock/core/constexpr_math.hpp"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Normalized (a0 = 1) biquad: y = b0 x + b1 x[-1] + b2 x[-2] - a1 y[-1] - a2 y[-2].
+struct BiquadCoeffs {
+    double b0{1.0};
+    double b1{0.0};
+    double b2{0.0};
+    double a1{0.0};
+    double a2{0.0};
+};
+
+inline constexpr double kButterworthQ = 0.70710678118654752440;
+
+namespace detail {
+inline constexpr double kTwoPi = 6.28318530717958647692;
+
+struct Prewarp {
+    double cos_w;
+    double alpha;
+};
+
+constexpr Prewarp prewarp(double sample_rate_hz, double f_hz, double q) {
+    const double w = kTwoPi * f_hz / sample_rate_hz;
+    return {cx::cos(w), cx::sin(w) / (2.0 * q)};
+}
+
+constexpr BiquadCoeffs normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+    return {b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+constexpr double one_pole_alpha(double sample_rate_hz, double cutoff_hz) {
+    const double rc = 1.0 / (kTwoPi * cutoff_hz);
+    const double dt = 1.0 / sample_rate_hz;
+    return dt / (rc + dt);
+}
+} // namespace detail
+
+// Bilinear-transform (RBJ cookbook) second-order designs. constexpr, so a sample rate known at compile
+// time gives compile-time coefficients.
+constexpr BiquadCoeffs design_lowpass(double sample_rate_hz, double cutoff_hz, double q = kButterworthQ) {
+    const auto [c, alpha] = detail::prewarp(sample_rate_hz, cutoff_hz, q);
+    return detail::normalize((1.0 - c) / 2.0, 1.0 - c, (1.0 - c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+constexpr BiquadCoeffs design_highpass(double sample_rate_hz, double cutoff_hz, double q = kButterworthQ) {
+    const auto [c, alpha] = detail::prewarp(sample_rate_hz, cutoff_hz, q);
+    return detail::normalize((1.0 + c) / 2.0, -(1.0 + c), (1.0 + c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+// 0 dB peak gain.
+constexpr BiquadCoeffs design_bandpass(double sample_rate_hz, double center_hz, double q) {
+    const auto [c, alpha] = detail::prewarp(sample_rate_hz, center_hz, q);
+    return detail::normalize(alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+// First-order sections matching IirLowPass (and x - IirLowPass(x) for the high-pass).
+constexpr BiquadCoeffs design_one_pole_lowpass(double sample_rate_hz, double cutoff_hz) {
+    const double a = detail::one_pole_alpha(sample_rate_hz, cutoff_hz);
+    return {a, 0.0, 0.0, -(1.0 - a), 0.0};
+}
+
+constexpr BiquadCoeffs design_one_pole_highpass(double sample_rate_hz, double cutoff_hz) {
+    const double a = detail::one_pole_alpha(sample_rate_hz, cutoff_hz);
+    return {1.0 - a, -(1.0 - a), 0.0, -(1.0 - a), 0.0};
+}
+
+// Sections biquads in series, applied to Lanes independent channels (e.g. I/Q, or I/Q of several bands)
+// in one pass. State and coefficients are stored lane-minor, so the per-section lane loop maps onto SIMD
+// registers. Transposed direct form II; no allocation.
+template <std::size_t Sections, std::size_t Lanes>
+class BiquadCascade {
+  public:
+    static_assert(Sections > 0 && Lanes > 0);
+    using LaneCoeffs = std::array<BiquadCoeffs, Sections>;
+
+    void set_lane(std::size_t lane, const LaneCoeffs& coeffs) {
+        for (std::size_t s = 0; s < Sections; ++s) {
+            sections_[s].b0[lane] = coeffs[s].b0;
+            sections_[s].b1[lane] = coeffs[s].b1;
+            sections_[s].b2[lane] = coeffs[s].b2;
+            sections_[s].a1[lane] = coeffs[s].a1;
+            sections_[s].a2[lane] = coeffs[s].a2;
+        }
+    }
+
+    void set_all_lanes(const LaneCoeffs& coeffs) {
+        for (std::size_t l = 0; l < Lanes; ++l) set_lane(l, coeffs);
+    }
+
+    void reset() {
+        for (auto& s : sections_) {
+            s.z1.fill(0.0);
+            s.z2.fill(0.0);
+        }
+    }
+
+    // All spans share one length; out[l] may alias in[l].
+    void process_block(const std::array<std::span<const double>, Lanes>& in,
+                       const std::array<std::span<double>, Lanes>& out) {
+        // Local state: the output stores could alias members, which would force state reloads. The lane
+        // loops are expanded at compile time so the state stays in registers at any lane count.
+        std::array<std::array<double, Lanes>, Sections> z1;
+        std::array<std::array<double, Lanes>, Sections> z2;
+        for (std::size_t s = 0; s < Sections; ++s) {
+            z1[s] = sections_[s].z1;
+            z2[s] = sections_[s].z2;
+        }
+        const std::size_t n = in[0].size();
+        for (std::size_t k = 0; k < n; ++k) {
+            std::array<double, Lanes> x;
+            for_each_lane([&](std::size_t l) { x[l] = in[l][k]; });
+            for (std::size_t s = 0; s < Sections; ++s) {
+                const auto& c = sections_[s];
+                for_each_lane([&](std::size_t l) {
+                    const double y = c.b0[l] * x[l] + z1[s][l];
+                    z1[s][l] = (c.b1[l] * x[l] + z2[s][l]) - c.a1[l] * y; // y last: shorter recurrence
+                    z2[s][l] = c.b2[l] * x[l] - c.a2[l] * y;
+                    x[l] = y;
+                });
+            }
+            for_each_lane([&](std::size_t l) { out[l][k] = x[l]; });
+        }
+        for (std::size_t s = 0; s < Sections; ++s) {
+            sections_[s].z1 = z1[s];
+            sections_[s].z2 = z2[s];
+        }
+    }
+
+  private:
+    template <typename F>
+    static void for_each_lane(F&& f) {
+        [&]<std::size_t... L>(std::index_sequence<L...>) { (f(L), ...); }(std::make_index_sequence<Lanes>{});
+    }
+
+    struct Section {
+        alignas(32) std::array<double, Lanes> b0{};
+        alignas(32) std::array<double, Lanes> b1{};
+        alignas(32) std::array<double, Lanes> b2{};
+        alignas(32) std::array<double, Lanes> a1{};
+        alignas(32) std::array<double, Lanes> a2{};
+        alignas(32) std::array<double, Lanes> z1{};
+        alignas(32) std::array<double, Lanes> z2{};
+    };
+    std::array<Section, Sections> sections_{};
+};
+
+// One cascade design over the I/Q rows of several channels: two channels (four lanes) share a
+// BiquadCascade, and an odd last channel gets a two-lane one. configure() allocates.
+template <std::size_t Sections>
+class IqFilterBank {
+  public:
+    using LaneCoeffs = typename BiquadCascade<Sections, 2>::LaneCoeffs;
+
+    void configure(std::size_t channels, const LaneCoeffs& coeffs) {
+        channels_ = channels;
+        pairs_.assign(channels / 2, {});
+        for (auto& p : pairs_) p.set_all_lanes(coeffs);
+        odd_.set_all_lanes(coeffs);
+        reset();
+    }
+
+    void reset() {
+        for (auto& p : pairs_) p.reset();
+        odd_.reset();
+    }
+
+    // Row c of each argument belongs to channel c; all rows share one length and outputs may alias inputs.
+    void process_block(std::span<const std::span<const double>> i_in, std::span<const std::span<const double>> q_in,
+                       std::span<const std::span<double>> i_out, std::span<const std::span<double>> q_out) {
+        for (std::size_t p = 0; p < pairs_.size(); ++p) {
+            const std::size_t c = 2 * p;
+            pairs_[p].process_block({i_in[c], q_in[c], i_in[c + 1], q_in[c + 1]},
+                                    {i_out[c], q_out[c], i_out[c + 1], q_out[c + 1]});
+        }
+        if (channels_ % 2 == 1) {
+            const std::size_t c = channels_ - 1;
+            odd_.process_block({i_in[c], q_in[c]}, {i_out[c], q_out[c]});
+        }
+    }
+
+  private:
+    std::size_t channels_{0};
+    std::vector<BiquadCascade<Sections, 4>> pairs_;
+    BiquadCascade<Sections, 2> odd_;
+};
+
+} // namespace sonarlock::core
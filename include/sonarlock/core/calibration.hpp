@@ -2,21 +2,49 @@
 
 #include "sonarlock/core/types.hpp"
 
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <utility>
 
 namespace sonarlock::core {
 
+// Constant-memory median/MAD estimator: a log-spaced histogram over [kMinValue, kMaxValue]
+// plus a bin for values below kMinValue (reported as 0). O(1) add, O(kBins) query, no allocation.
+// Error bound with d = relative_error() (half a bin, ~1%):
+//   |median - exact| <= d * median,   |mad - exact| <= d * (2 * median + mad).
+class StreamingMedianMad {
+  public:
+    static constexpr std::size_t kBins = 1024;
+    static constexpr double kMinValue = 1e-7;
+    static constexpr double kMaxValue = 100.0;
+
+    static double relative_error();
+
+    void reset();
+    void add(double x);
+    // Scales every bin by factor (0..1] so older samples fade out; count() is unaffected.
+    void decay(double factor);
+    [[nodiscard]] std::uint64_t count() const { return count_; }
+    [[nodiscard]] std::pair<double, double> median_mad() const; // {median, mad}; {0, 0} when empty
+
+  private:
+    std::array<double, kBins + 1> bins_{}; // bins_[0]: values below kMinValue
+    double weight_{0.0};
+    std::uint64_t count_{0};
+};
+
 class AutoTuner {
   public:
     explicit AutoTuner(CalibrationSection config);
     void reset();
     void add_sample(double relative_motion);
+    void decay(double factor);
     bool ready(std::size_t min_samples) const;
     void apply(DetectionSection& detection) const;
 
   private:
     CalibrationSection config_;
-    std::vector<double> samples_;
+    StreamingMedianMad stats_;
 };
 
 class CalibrationController {
@@ -24,13 +52,22 @@ class CalibrationController {
     CalibrationController(CalibrationSection cal, DetectionSection det);
     void reset();
     CalibrationState state() const;
-    void update(double timestamp_sec, double relative_motion, DetectionSection& det_inout);
+    // With cal.adapt the tuned thresholds are written into det_inout on every call once Armed;
+    // only samples taken while detector_state is Idle feed the noise statistics.
+    void update(double timestamp_sec, double relative_motion, DetectionSection& det_inout,
+                DetectionState detector_state = DetectionState::Idle);
+    [[nodiscard]] std::uint64_t threshold_updates() const { return threshold_updates_; }
 
   private:
+    void adapt(double timestamp_sec);
+
     CalibrationSection cal_;
     DetectionSection default_det_;
+    DetectionSection tuned_det_;
     CalibrationState state_{CalibrationState::Init};
     AutoTuner tuner_;
+    double last_adapt_sec_{0.0};
+    std::uint64_t threshold_updates_{0};
 };
 
 } // namespace sonarlock::core
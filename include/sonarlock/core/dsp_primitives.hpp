@@ -1,30 +1,107 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <utility>
 
 namespace sonarlock::core {
 
+// Direct: std::cos/std::sin per sample (reference).
+// Recurrence: complex phasor rotation, re-anchored to the exact phase every kNcoCheckInterval samples.
+// Lut: 4096-entry cosine table with linear interpolation.
+// All modes share a 64-bit fixed-point phase accumulator, so the phase itself never drifts.
+enum class NcoMode { Direct, Recurrence, Lut };
+
+inline constexpr std::uint32_t kNcoCheckInterval = 256;
+
 class Nco {
   public:
-    Nco(double sample_rate_hz, double frequency_hz);
+    Nco(double sample_rate_hz, double frequency_hz, NcoMode mode = NcoMode::Recurrence);
     std::pair<double, double> next(); // cos, sin
+    void fill(std::span<double> cos_out, std::span<double> sin_out);
+    void set_frequency(double frequency_hz); // keeps the current phase
+    void reset();
+
+    [[nodiscard]] NcoMode mode() const { return mode_; }
+    // Worst phase error (radians) seen at the periodic exact-phase checks since construction.
+    [[nodiscard]] double max_phase_error() const { return max_phase_error_; }
+    [[nodiscard]] static double phase_error_bound(NcoMode mode);
 
   private:
+    void check_phase();
+    [[nodiscard]] double phase_radians() const;
+
+    NcoMode mode_;
     double sample_rate_hz_;
-    double frequency_hz_;
-    double phase_{0.0};
+    std::uint64_t phase_{0};
+    std::uint64_t phase_inc_{0};
+    double rot_c_{1.0};
+    double rot_s_{0.0};
+    double z_c_{1.0};
+    double z_s_{0.0};
+    std::uint32_t until_check_{0};
+    double max_phase_error_{0.0};
 };
 
 class IirLowPass {
   public:
     IirLowPass(double sample_rate_hz, double cutoff_hz);
     double process(double x);
+    void process_block(std::span<const double> in, std::span<double> out); // in may alias out
 
   private:
     double alpha_;
     double y_{0.0};
 };
 
+// Order-4 CIC decimator followed by a 3-tap droop compensation FIR at the output rate.
+// Integrators and combs run in wrapping 64-bit fixed point, so they never accumulate error.
+// The decimation phase carries across blocks: output k is emitted at input sample
+// k * factor + factor - 1 of the stream. Its content is centred group_delay(factor) input samples
+// earlier: the CIC's kOrder * (factor - 1) / 2, plus one output sample of FIR delay.
+class CicDecimator {
+  public:
+    static constexpr int kOrder = 4;
+    static constexpr std::uint32_t kMaxFactor = 64; // keeps factor^4 gain inside 64-bit headroom
+
+    explicit CicDecimator(std::uint32_t factor);
+    [[nodiscard]] std::uint32_t factor() const { return factor_; }
+    // Input samples from an output's emitting sample back to the centre of its impulse response.
+    [[nodiscard]] static constexpr double group_delay(std::uint32_t factor) {
+        return kOrder * (static_cast<double>(factor) - 1.0) / 2.0 + static_cast<double>(factor);
+    }
+    // Index within the next block of the input sample that produces its first output.
+    [[nodiscard]] std::size_t next_output_offset() const { return factor_ - 1 - phase_; }
+    // Writes one output per factor inputs and returns how many; out needs in.size() / factor + 1
+    // slots. in may alias out.
+    std::size_t process_block(std::span<const double> in, std::span<double> out);
+    void reset();
+
+  private:
+    std::uint32_t factor_;
+    std::uint32_t phase_{0};
+    double out_scale_;
+    double comp_a_;
+    std::array<std::uint64_t, kOrder> integ_{};
+    std::array<std::uint64_t, kOrder> comb_{};
+    double fir_z1_{0.0};
+    double fir_z2_{0.0};
+};
+
+// Block replacement for PhaseTracker + differencing: step[n] = arg(z[n] * conj(z[n-1])), the unwrapped
+// phase difference, via kernels::phase_step (no atan2 per sample). The first sample after reset() yields 0.
+class PhaseDifferentiator {
+  public:
+    void process_block(std::span<const double> i, std::span<const double> q, std::span<double> step_out);
+    void reset();
+
+  private:
+    double prev_i_{0.0};
+    double prev_q_{0.0};
+};
+
 class PhaseTracker {
   public:
     double unwrap(double i, double q);
@@ -1,19 +1,45 @@
 #pragma once
 
-#include <deque>
+#include "sonarlock/core/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace sonarlock::core {
 
+enum class JournalEventKind : std::uint8_t { SessionStart, Update };
+
+// Compact POD record; JSON is only produced by EventJournal::dump_json_array.
+struct JournalRecord {
+    double timestamp_sec{0.0};
+    float score{0.0F};
+    float relative_motion{0.0F};
+    JournalEventKind kind{JournalEventKind::Update};
+    DetectionState state{DetectionState::Idle};
+    CalibrationState calibration{CalibrationState::Init};
+    ActionType action{ActionType::None};
+};
+static_assert(std::is_trivially_copyable_v<JournalRecord>);
+
+// Fixed-capacity ring of JournalRecord, allocated once; push() is a plain store.
 class EventJournal {
   public:
-    explicit EventJournal(std::size_t capacity = 128);
-    void push(std::string event_json_line);
+    explicit EventJournal(std::size_t capacity); // LoggingSection::journal_capacity holds the default
+    void push(const JournalRecord& record);
+    void clear() { head_ = size_ = 0; }
+    // Replaces out with the retained records, oldest first.
+    void copy_to(std::vector<JournalRecord>& out) const;
+    [[nodiscard]] std::size_t capacity() const { return records_.size(); }
+    [[nodiscard]] std::size_t size() const { return size_; }
     std::string dump_json_array(std::size_t max_items) const;
 
   private:
-    std::size_t capacity_;
-    std::deque<std::string> events_;
+    std::vector<JournalRecord> records_;
+    std::size_t head_{0};
+    std::size_t size_{0};
 };
 
 } // namespace sonarlock::core
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/mapped_file.hpp"
+#include "sonarlock/core/ring_writer.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Fused features of one detection update, as the pipeline handed them to the detector.
+struct FeatureFrame {
+    double timestamp_sec{0.0};
+    MotionFeatures features;
+};
+
+// Columnar feature trace (.sltrace), native byte order:
+//   [0, 4096)  FeatureTraceHeader, zero padded
+//   blocks     u64 rows, then kTraceColumns columns of rows doubles each
+// Columns are timestamp_sec followed by the MotionFeatures fields in declaration order. Blocks hold
+// at most kTraceBlockRows rows; a truncated final block (crash while writing) is ignored on read.
+inline constexpr std::size_t kTraceColumns = 12;
+inline constexpr std::size_t kTraceBlockRows = 1024;
+inline constexpr std::size_t kTraceHeaderBytes = 4096;
+inline constexpr std::uint32_t kTraceVersion = 2;
+inline constexpr std::uint64_t kTraceUnknownRows = ~std::uint64_t{0};
+
+// Columns 1.. hold the kFeatureFields in order.
+static_assert(kFeatureFields.size() == kTraceColumns - 1);
+
+// The session config the features were computed with; fixed-width fields only.
+struct FeatureTraceHeader {
+    std::array<char, 8> magic{};
+    std::uint32_t byte_order{0}; // 0x01020304 as written
+    std::uint32_t version{0};
+    std::uint32_t columns{0};
+    std::uint32_t block_rows{0};
+    std::uint64_t rows{0}; // kTraceUnknownRows until the writer closes
+    double sample_rate_hz{0.0};
+    std::uint64_t frames_per_buffer{0};
+    std::uint64_t input_channels{0};
+    double f0_hz{0.0};
+    std::uint32_t decimation{0};
+    std::uint32_t filter_design{0};
+    double lp_cutoff_hz{0.0};
+    double doppler_band_low_hz{0.0};
+    double doppler_band_high_hz{0.0};
+    double baseline_alpha{0.0};
+    double baseline_motion_alpha{0.0};
+    std::uint64_t stft_size{0};
+    std::uint64_t stft_hop{0};
+    double stft_rate_hz{0.0};
+    double trigger_threshold{0.0};
+    double release_threshold{0.0};
+    std::uint32_t debounce_ms{0};
+    std::uint32_t cooldown_ms{0};
+    std::uint32_t arming_delay_ms{0};
+    std::uint32_t lock_cooldown_ms{0};
+    std::uint32_t max_locks_per_minute{0};
+    std::uint32_t calibration_enabled{0};
+    double warmup_seconds{0.0};
+    double calibrate_seconds{0.0};
+    double trigger_k{0.0};
+    double release_k{0.0};
+    double min_threshold{0.0};
+    double max_threshold{0.0};
+    std::uint32_t adapt{0};
+    std::uint32_t action_mode{0};
+    double adapt_interval_seconds{0.0};
+    double adapt_window_seconds{0.0};
+    double adapt_max_step{0.0};
+    std::uint32_t manual_disable{0};
+    std::uint32_t scenario{0};
+    std::uint32_t seed{0};
+    std::uint32_t reserved{0};
+    std::array<std::array<char, 24>, kTraceColumns> column_names{};
+
+    static FeatureTraceHeader from_config(const AudioConfig& config);
+    // Overwrites the fields the header carries; everything else in config is kept.
+    void apply_to(AudioConfig& config) const;
+};
+
+const char* trace_column_name(std::size_t column);
+
+// Receives the features of every process() call from a FeatureTap.
+class IFeatureSink {
+  public:
+    virtual ~IFeatureSink() = default;
+    // Outside the audio thread, before the session's first push().
+    virtual void begin_session(const AudioConfig& config) = 0;
+    // Audio thread.
+    virtual void push(const FeatureFrame& frame) = 0;
+};
+
+// Passes everything through to inner and hands sink its features after each process() call, stamped
+// with the timestamp the pipeline gives its detector.
+class FeatureTap final : public ForwardingPipeline {
+  public:
+    FeatureTap(IDspPipeline& inner, IFeatureSink& sink) : ForwardingPipeline(inner), sink_(sink) {}
+
+    void begin_session(const AudioConfig& config) override;
+    void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override;
+
+  private:
+    IFeatureSink& sink_;
+    double sample_rate_hz_{48000.0};
+};
+
+// Streams feature frames to a trace file. push() runs on the audio thread: it copies the frame into
+// a RingWriter or counts it as dropped. The writer thread transposes rows into column blocks and
+// writes each block when it fills and on close().
+class FeatureTraceWriter final : public IFeatureSink {
+  public:
+    FeatureTraceWriter() = default;
+    ~FeatureTraceWriter() override;
+    FeatureTraceWriter(const FeatureTraceWriter&) = delete;
+    FeatureTraceWriter& operator=(const FeatureTraceWriter&) = delete;
+
+    // ring_rows frames may be queued before push() starts dropping.
+    Status open(const std::string& path, const AudioConfig& config, std::size_t ring_rows = 4 * kTraceBlockRows);
+    // Takes the session's config for the header written by close().
+    void begin_session(const AudioConfig& config) override { header_ = FeatureTraceHeader::from_config(config); }
+    void push(const FeatureFrame& frame) override;
+    // Writes the last block, finalises the header and joins the writer. Reports write failures.
+    Status close();
+
+    [[nodiscard]] bool is_open() const { return file_ != nullptr; }
+    [[nodiscard]] std::uint64_t dropped_rows() const { return ring_.dropped(); }
+    [[nodiscard]] std::uint64_t rows_written() const { return rows_written_; }
+
+  private:
+    bool write_block(std::span<const FeatureFrame> rows);
+
+    std::FILE* file_{nullptr};
+    FeatureTraceHeader header_;
+    RingWriter<FeatureFrame> ring_;
+    std::vector<double> columns_;   // writer thread: one block, column-major
+    std::uint64_t rows_written_{0}; // writer thread; read after close()
+};
+
+// Memory-mapped trace; columns are read in place.
+class FeatureTraceReader {
+  public:
+    struct Block {
+        std::size_t rows{0};
+        const double* data{nullptr};
+        [[nodiscard]] std::span<const double> column(std::size_t c) const { return {data + c * rows, rows}; }
+    };
+
+    Status open(const std::string& path);
+    [[nodiscard]] const FeatureTraceHeader& header() const { return header_; }
+    [[nodiscard]] std::span<const Block> blocks() const { return blocks_; }
+    [[nodiscard]] std::uint64_t rows() const { return rows_; }
+
+  private:
+    MappedFile file_;
+    FeatureTraceHeader header_;
+    std::vector<Block> blocks_;
+    std::uint64_t rows_{0};
+};
+
+struct ReplayResult {
+    RuntimeMetrics metrics; // detection fields, features and thresholds of the last row
+    std::uint64_t actions{0}; // requests the safety controller let through
+};
+
+// Drives CalibrationController, MotionDetector, DefaultActionPolicy and ActionSafetyController over a
+// trace in the order BasicDspPipeline::process uses, so the same config reproduces the live session.
+ReplayResult replay_trace(const FeatureTraceReader& trace, const AudioConfig& config);
+
+} // namespace sonarlock::core
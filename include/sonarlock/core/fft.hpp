@@ -0,0 +1,29 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace sonarlock::core {
+
+// In-place complex FFT for power-of-two sizes: bit-reversal, one radix-2 stage when log2(n) is odd,
+// then radix-4 stages. Twiddles and the permutation are built in the constructor; forward() and
+// inverse() never allocate.
+class FftPlan {
+  public:
+    explicit FftPlan(std::size_t n = 1); // n is rounded up to a power of two
+    [[nodiscard]] std::size_t size() const { return n_; }
+    void forward(std::span<std::complex<double>> data) const;  // X[k] = sum x[m] e^{-2 pi i km/n}
+    void inverse(std::span<std::complex<double>> data) const;  // unscaled
+
+  private:
+    void transform(std::span<std::complex<double>> data, bool inverse) const;
+
+    std::size_t n_{1};
+    std::size_t log2_{0};
+    std::vector<std::size_t> bitrev_;
+    std::vector<std::complex<double>> twiddle_; // e^{-2 pi i k / n}, k < n
+};
+
+} // namespace sonarlock::core
@@ -13,11 +13,16 @@ class Logger {
   public:
     virtual ~Logger() = default;
     virtual void write(LogLevel level, std::string_view message) = 0;
+    // Blocks until everything written so far has reached its sinks.
+    virtual void flush() {}
 };
 
+// Asynchronous: write() only enqueues; a background thread batches output to stdout and the
+// rotated log file. Overflow follows LoggingSection::overflow.
 std::unique_ptr<Logger> make_console_file_logger(const LoggingSection& cfg);
 
 void log(LogLevel level, std::string_view message);
 void set_global_logger(std::unique_ptr<Logger> logger);
+void flush_log();
 
 } // namespace sonarlock::core
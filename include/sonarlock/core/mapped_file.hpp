@@ -0,0 +1,32 @@
+#pragma once
+
+#include "sonarlock/core/types.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace sonarlock::core {
+
+// Read-only mapping of a whole file (POSIX mmap or a Win32 file mapping); an empty file maps to
+// an empty span.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    Status open(const std::string& path);
+    void close();
+
+    [[nodiscard]] std::span<const std::byte> bytes() const { return {data_, data_ ? size_ : 0}; }
+
+  private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+    void* file_{nullptr}; // Win32 handles
+    void* mapping_{nullptr};
+};
+
+} // namespace sonarlock::core
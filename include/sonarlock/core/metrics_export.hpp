@@ -0,0 +1,53 @@
+#pragma once
+
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace sonarlock::core {
+
+// Appends m in the Prometheus text exposition format (metric prefix sonarlock_, durations in seconds).
+void append_prometheus(std::string& out, const RuntimeMetrics& m);
+
+// Writes pipeline.snapshot() as Prometheus text every interval_ms from a background thread, for
+// node_exporter's textfile collector or any scraper that reads files. Each export is written to
+// path.tmp and renamed over path, so readers never see a partial file. The audio thread is not
+// involved beyond the seqlock publish BasicDspPipeline does anyway.
+class MetricsExporter {
+  public:
+    MetricsExporter() = default;
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Writes the first export before returning, so an unwritable path is reported here.
+    Status start(const IDspPipeline& pipeline, const std::string& path, std::uint32_t interval_ms);
+    // Writes a final export and joins the thread.
+    void stop();
+
+    [[nodiscard]] std::uint64_t exports() const { return exports_.load(std::memory_order_relaxed); }
+
+  private:
+    void run();
+    bool export_once();
+
+    const IDspPipeline* pipeline_{nullptr};
+    std::string path_;
+    std::string tmp_path_;
+    std::chrono::milliseconds interval_{1000};
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_{false};
+    std::atomic<std::uint64_t> exports_{0};
+    std::string text_; // exporter thread
+};
+
+} // namespace sonarlock::core
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "sonarlock/core/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace sonarlock::core {
+
+// The RuntimeMetrics fields a pipeline changes per callback, as a plain trivial struct so a Seqlock
+// can copy it word by word. Backend counters and CallbackTiming are not part of it; snapshot()
+// takes timing from the live CallbackTimer instead.
+struct MetricsSnapshot {
+    double sample_rate_hz;
+    std::uint64_t frames_per_buffer;
+    std::uint64_t input_channels;
+    std::uint64_t dominant_channel;
+    std::uint64_t callbacks;
+    std::uint64_t frames_processed;
+    std::uint64_t callback_allocations;
+    std::uint64_t triggered_count;
+    std::uint64_t threshold_updates;
+    float peak_level;
+    float rms_level;
+    float dc_offset;
+    DetectionState state;
+    CalibrationState calibration;
+    ActionType action;
+    double score;
+    double confidence;
+    double event_timestamp_sec;
+    double action_timestamp_sec;
+    const char* action_reason; // ActionRequest::reason points at static storage
+    std::uint64_t action_reason_size;
+    double trigger_threshold;
+    double release_threshold;
+    std::array<double, kFeatureFields.size()> features; // kFeatureFields order
+
+    static MetricsSnapshot from(const RuntimeMetrics& m);
+    // Overwrites the fields the snapshot carries; everything else in m is kept.
+    void apply_to(RuntimeMetrics& m) const;
+};
+
+static_assert(std::is_trivial_v<MetricsSnapshot> && std::is_standard_layout_v<MetricsSnapshot>);
+
+} // namespace sonarlock::core
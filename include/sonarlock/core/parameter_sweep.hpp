@@ -0,0 +1,79 @@
+#pragma once
+
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/feature_trace.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Feature stream of one scenario or recording. Triggers inside [motion_start_sec, motion_end_sec]
+// are detections; any other trigger is false. A negative start means the trace has no motion.
+// The baseline rates and channel count are those of the session that produced the frames.
+struct FeatureTrace {
+    std::string name;
+    std::vector<FeatureFrame> frames;
+    double motion_start_sec{-1.0};
+    double motion_end_sec{-1.0};
+    std::uint32_t input_channels{1};
+    double baseline_alpha{DspSection{}.baseline_alpha};
+    double baseline_motion_alpha{DspSection{}.baseline_motion_alpha};
+};
+
+// Collects a session's feature frames in memory, fed by a FeatureTap. Frames are reserved in
+// begin_session from duration_seconds, so finite sessions do not allocate per callback.
+class FeatureRecorder final : public IFeatureSink {
+  public:
+    void begin_session(const AudioConfig& config) override;
+    void push(const FeatureFrame& frame) override { frames_.push_back(frame); }
+
+    [[nodiscard]] std::vector<FeatureFrame> take_frames() { return std::move(frames_); }
+    // take_frames() into trace.frames, plus the session's baseline rates and channel count.
+    void take(FeatureTrace& trace);
+
+  private:
+    std::vector<FeatureFrame> frames_;
+    std::uint32_t input_channels_{1};
+    double baseline_alpha_{0.0};
+    double baseline_motion_alpha_{0.0};
+};
+
+// Values to try per DetectionSection field; an empty axis keeps the base value.
+struct SweepGrid {
+    std::vector<double> trigger_threshold;
+    std::vector<double> release_threshold;
+    std::vector<std::uint32_t> debounce_ms;
+    std::vector<std::uint32_t> cooldown_ms;
+
+    [[nodiscard]] bool empty() const {
+        return trigger_threshold.empty() && release_threshold.empty() && debounce_ms.empty() && cooldown_ms.empty();
+    }
+};
+
+// Cartesian product of the axes (cooldown varies fastest). Points with release >= trigger are skipped.
+std::vector<DetectionSection> expand_grid(const DetectionSection& base, const SweepGrid& grid);
+
+struct SweepResult {
+    DetectionSection detection;
+    std::uint64_t triggers{0};
+    std::uint64_t false_triggers{0};
+    std::size_t detected{0};          // motion traces with a trigger inside their window
+    std::size_t motion_traces{0};
+    double mean_latency_sec{-1.0};    // window start to first trigger, over detected traces; < 0 if none
+};
+
+// Replays calibration, DefaultMotionScorer and DetectionStateMachine over the cached traces for every
+// grid point, split across workers (0: hardware_concurrency). The baseline follows the detector state
+// (baseline_motion_alpha while Observing/Triggered), so relative_motion depends on the point: for mono
+// traces it is recomputed from doppler_band_energy per point and results match live sessions with the
+// same detection config. Multichannel traces hold only the fused channel, so they replay the recorded
+// relative_motion and are approximate.
+std::vector<SweepResult> run_sweep(std::span<const FeatureTrace> traces, std::span<const DetectionSection> grid,
+                                   const CalibrationSection& calibration, std::size_t workers = 0);
+
+} // namespace sonarlock::core
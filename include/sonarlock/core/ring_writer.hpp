@@ -0,0 +1,94 @@
+#pragma once
+
+#include "sonarlock/core/spsc_ring.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace sonarlock::core {
+
+// The audio-thread-to-disk plumbing of the capture, feature trace and series writers. push() copies
+// items into a preallocated SPSC ring, or counts them as dropped when it is full; it never blocks or
+// allocates. A writer thread polls the ring every idle_wait and hands the sink exactly batch items at
+// a time; stop() drains what is left in shorter batches. After the sink reports a write failure the
+// remaining items are still drained but not handed over.
+template <typename T>
+class RingWriter {
+  public:
+    // Writer thread; returns false when a write failed.
+    using Sink = std::function<bool(std::span<const T>)>;
+
+    RingWriter() = default;
+    ~RingWriter() { stop(); }
+    RingWriter(const RingWriter&) = delete;
+    RingWriter& operator=(const RingWriter&) = delete;
+
+    // Allocates the ring (at least min_items, rounded up to a power of two); see capacity().
+    void reserve(std::size_t min_items) { ring_ = std::make_unique<SpscRing<T>>(min_items); }
+    // After reserve(); batch must not exceed capacity().
+    void start(std::size_t batch, std::chrono::milliseconds idle_wait, Sink sink) {
+        batch_ = batch;
+        idle_wait_ = idle_wait;
+        sink_ = std::move(sink);
+        failed_ = false;
+        dropped_.store(0, std::memory_order_relaxed);
+        running_.store(true, std::memory_order_release);
+        writer_ = std::thread([this] { run(); });
+    }
+    // Hands everything queued to the sink, joins the writer and frees the ring.
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        if (writer_.joinable()) writer_.join();
+        ring_.reset();
+    }
+
+    // Audio thread: all of items or nothing.
+    bool push(std::span<const T> items) {
+        if (ring_ && ring_->push(items)) return true;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // For producers without a deadline (offline backends): waits for room instead of dropping.
+    void push_wait(std::span<const T> items) {
+        if (!ring_) return;
+        while (!ring_->push(items)) std::this_thread::yield();
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return ring_ ? ring_->capacity() : 0; }
+    // Rejected push() calls.
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    // Read after stop().
+    [[nodiscard]] bool failed() const { return failed_; }
+
+  private:
+    void run() {
+        std::vector<T> batch(batch_);
+        const auto deliver = [&](std::size_t n) {
+            if (!failed_ && !sink_(std::span<const T>(batch.data(), n))) failed_ = true;
+        };
+        for (;;) {
+            const bool stopping = !running_.load(std::memory_order_acquire);
+            if (ring_->pop(batch)) deliver(batch.size());
+            else if (stopping) break;
+            else std::this_thread::sleep_for(idle_wait_);
+        }
+        while (const std::size_t n = ring_->pop_some(batch)) deliver(n);
+    }
+
+    std::unique_ptr<SpscRing<T>> ring_;
+    std::size_t batch_{1};
+    std::chrono::milliseconds idle_wait_{5};
+    Sink sink_;
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    bool failed_{false}; // writer thread
+};
+
+} // namespace sonarlock::core
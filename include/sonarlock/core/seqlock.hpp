@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace sonarlock::core {
+
+// Single-writer sequence lock for a trivial, standard-layout value. store() never blocks or allocates: it
+// bumps the sequence to odd, writes the value as relaxed atomic words and bumps it back to even.
+// load() may run on any number of threads at once; it only retries when it overlapped a store, so
+// a reader of a value published once per audio callback practically never loops.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivial_v<T> && std::is_standard_layout_v<T>);
+
+  public:
+    Seqlock() { store(T{}); }
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // Writer thread only.
+    void store(const T& value) {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) data_[i].store(words[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    [[nodiscard]] T load() const {
+        Words words{};
+        for (unsigned spins = 0;; ++spins) {
+            const std::uint64_t before = seq_.load(std::memory_order_acquire);
+            if ((before & 1U) == 0) {
+                for (std::size_t i = 0; i < kWords; ++i) words[i] = data_[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == before) break;
+            }
+            if (spins >= 64) std::this_thread::yield(); // writer preempted mid-store
+        }
+        T out;
+        std::memcpy(&out, words.data(), sizeof(T));
+        return out;
+    }
+
+    // Two per completed store; odd while a store is in progress.
+    [[nodiscard]] std::uint64_t sequence() const { return seq_.load(std::memory_order_acquire); }
+
+  private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    using Words = std::array<std::uint64_t, kWords>;
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, kWords> data_{};
+};
+
+} // namespace sonarlock::core
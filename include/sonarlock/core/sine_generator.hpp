@@ -1,6 +1,9 @@
 #pragma once
 
+#include "sonarlock/core/dsp_primitives.hpp"
+
 #include <cstddef>
+#include <span>
 #include <vector>
 
 namespace sonarlock::core {
@@ -12,13 +15,12 @@ class SineGenerator {
     void set_frequency(double frequency_hz);
     void reset();
 
-    void generate(std::vector<float>& out, std::size_t total_frames, std::size_t frame_offset);
+    // Writes the tone straight into out; no allocation. frame_offset is the absolute frame of out[0].
+    void generate(std::span<float> out, std::size_t total_frames, std::size_t frame_offset);
 
   private:
-    double sample_rate_hz_;
-    double frequency_hz_;
-    double phase_{0.0};
-    std::size_t fade_samples_{0};
+    Nco osc_;
+    std::vector<float> fade_ramp_; // fade_ramp_[k] = k / fade_samples
 };
 
 } // namespace sonarlock::core
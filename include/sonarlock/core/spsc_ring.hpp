@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace sonarlock::core {
+
+// Lock-free single-producer/single-consumer ring. Storage is allocated once in the
+// constructor (capacity rounded up to a power of two); push/pop never allocate or block.
+template <typename T>
+class SpscRing {
+  public:
+    explicit SpscRing(std::size_t min_capacity) : buffer_(round_up(min_capacity)), mask_(buffer_.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const { return buffer_.size(); }
+
+    // Consumer-side view: items ready to pop. Producer-side view: lower bound.
+    [[nodiscard]] std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    // Producer: writes all of items or nothing.
+    bool push(std::span<const T> items) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        if (capacity() - (head - tail) < items.size()) return false;
+        copy_in(head, items);
+        head_.store(head + items.size(), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: reads exactly out.size() items or nothing.
+    bool pop(std::span<T> out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        if (head - tail < out.size()) return false;
+        copy_out(tail, out);
+        tail_.store(tail + out.size(), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: reads up to out.size() items, returns the count.
+    std::size_t pop_some(std::span<T> out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t n = std::min(out.size(), head - tail);
+        copy_out(tail, out.first(n));
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+  private:
+    static std::size_t round_up(std::size_t n) {
+        std::size_t c = 1;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    void copy_in(std::size_t pos, std::span<const T> items) {
+        const std::size_t start = pos & mask_;
+        const std::size_t first = std::min(items.size(), capacity() - start);
+        std::copy_n(items.begin(), first, buffer_.begin() + static_cast<std::ptrdiff_t>(start));
+        std::copy(items.begin() + static_cast<std::ptrdiff_t>(first), items.end(), buffer_.begin());
+    }
+
+    void copy_out(std::size_t pos, std::span<T> out) const {
+        const std::size_t start = pos & mask_;
+        const std::size_t first = std::min(out.size(), capacity() - start);
+        std::copy_n(buffer_.begin() + static_cast<std::ptrdiff_t>(start), first, out.begin());
+        std::copy_n(buffer_.begin(), out.size() - first, out.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+
+    std::vector<T> buffer_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+} // namespace sonarlock::core
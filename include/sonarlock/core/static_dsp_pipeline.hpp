@@ -0,0 +1,478 @@
+#pragma once
+
+#include "sonarlock/core/action_policy.hpp"
+#include "sonarlock/core/biquad.hpp"
+#include "sonarlock/core/calibration.hpp"
+#include "sonarlock/core/callback_timing.hpp"
+#include "sonarlock/core/constexpr_math.hpp"
+#include "sonarlock/core/doppler_spectrogram.hpp"
+#include "sonarlock/core/dsp_kernels.hpp"
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/dsp_primitives.hpp"
+#include "sonarlock/core/event_journal.hpp"
+#include "sonarlock/core/motion_detection.hpp"
+#include "sonarlock/core/metrics_snapshot.hpp"
+#include "sonarlock/core/seqlock.hpp"
+#include "sonarlock/core/sine_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sonarlock::core {
+
+// The settings that fix a StaticDspPipeline's stage types and filter coefficients at compile time.
+// Everything else (baseline rates, STFT, calibration, detection, actions) is still read from the
+// session config.
+struct StaticDspSpec {
+    double sample_rate_hz{48000.0};
+    double f0_hz{19000.0};
+    std::size_t input_channels{1};
+    std::uint32_t decimation{1};
+    FilterDesign filter_design{FilterDesign::OnePole};
+    double lp_cutoff_hz{500.0};
+    double doppler_band_low_hz{20.0};
+    double doppler_band_high_hz{200.0};
+};
+
+// True when config selects exactly the front end spec describes, with the clamping BasicDspPipeline applies.
+inline bool matches(const StaticDspSpec& spec, const AudioConfig& config) {
+    return config.audio.sample_rate_hz == spec.sample_rate_hz && config.audio.f0_hz == spec.f0_hz &&
+           std::clamp<std::size_t>(config.audio.input_channels, 1, kMaxInputChannels) == spec.input_channels &&
+           std::clamp<std::uint32_t>(config.dsp.decimation, 1, CicDecimator::kMaxFactor) == spec.decimation &&
+           config.dsp.filter_design == spec.filter_design && config.dsp.lp_cutoff_hz == spec.lp_cutoff_hz &&
+           config.dsp.doppler_band_low_hz == spec.doppler_band_low_hz &&
+           config.dsp.doppler_band_high_hz == spec.doppler_band_high_hz;
+}
+
+// Nco in Recurrence mode with the phase increment and rotation fixed at compile time. Same fixed-point
+// phase and exact re-anchoring every kNcoCheckInterval samples, so the output tracks Nco to the last
+// bit of the rotation constants.
+template <double SampleRateHz, double FrequencyHz>
+class StaticNco {
+  public:
+    static_assert(SampleRateHz > 0.0 && FrequencyHz >= 0.0);
+
+    void reset() { *this = StaticNco{}; }
+
+    // cos, sin of the current phase; then advances one sample.
+    std::pair<double, double> next() {
+        if (until_check_ == 0) anchor();
+        --until_check_;
+        const double c = z_c_;
+        const double s = z_s_;
+        z_c_ = c * kRotCos - s * kRotSin;
+        z_s_ = c * kRotSin + s * kRotCos;
+        phase_ += kPhaseInc;
+        return {c, s};
+    }
+
+  private:
+    static constexpr double kTwoPi = 6.28318530717958647692;
+    static constexpr double turns(std::uint64_t phase) { return static_cast<double>(phase >> 11) * 0x1p-53; }
+    static constexpr std::uint64_t kPhaseInc = [] {
+        double cycles = FrequencyHz / SampleRateHz;
+        cycles -= cx::floor(cycles);
+        return static_cast<std::uint64_t>(cycles * 0x1p63) << 1;
+    }();
+    static constexpr double kRotCos = cx::cos(kTwoPi * turns(kPhaseInc));
+    static constexpr double kRotSin = cx::sin(kTwoPi * turns(kPhaseInc));
+
+    void anchor() {
+        const double ph = kTwoPi * turns(phase_);
+        z_c_ = std::cos(ph);
+        z_s_ = std::sin(ph);
+        until_check_ = kNcoCheckInterval;
+    }
+
+    std::uint64_t phase_{0};
+    double z_c_{1.0};
+    double z_s_{0.0};
+    std::uint32_t until_check_{0};
+};
+
+// Biquad sections in series with compile-time coefficients, run over Lanes independent signals in
+// lock step (the I and Q of every channel) so each operation covers all lanes; the arithmetic of
+// BiquadCascade. A first-order section (b2 = a2 = 0) keeps no second state.
+template <std::size_t Lanes, BiquadCoeffs... Sections>
+class StaticCascade {
+  public:
+    using Frame = std::array<double, Lanes>;
+
+    void step(Frame& x) {
+        std::apply([&x](auto&... s) { (s.step(x), ...); }, sections_);
+    }
+
+  private:
+    template <BiquadCoeffs C>
+    struct Section {
+        Frame z1{};
+        Frame z2{};
+
+        void step(Frame& x) {
+            for (std::size_t l = 0; l < Lanes; ++l) {
+                const double y = C.b0 * x[l] + z1[l];
+                if constexpr (C.b2 == 0.0 && C.a2 == 0.0) {
+                    z1[l] = C.b1 * x[l] - C.a1 * y;
+                } else {
+                    z1[l] = (C.b1 * x[l] + z2[l]) - C.a1 * y;
+                    z2[l] = C.b2 * x[l] - C.a2 * y;
+                }
+                x[l] = y;
+            }
+        }
+    };
+
+    std::tuple<Section<Sections>...> sections_{};
+};
+
+// BasicDspPipeline with its front end fixed by Spec: the NCO, filters and EMA coefficients are
+// compile-time constants, stages are value members, and scoring and action policy are called
+// directly instead of through IMotionScorer / IActionPolicy. The NCO, mixer, both filter chains (I and
+// Q of all channels as lanes of one cascade), magnitudes, Doppler energy and signal/noise EMAs run as
+// one fused per-sample loop that inlines completely. Phase differencing then goes through
+// kernels::phase_step, whose SIMD atan2 is cheaper than the scalar one inside the loop. Features agree
+// with BasicDspPipeline on the same config within rounding (reductions are summed in a different
+// order). CallbackTiming books the fused loop as Features; with decimation the mixer and CIC stage is
+// booked as Mix.
+template <StaticDspSpec Spec>
+class StaticDspPipeline final : public IDspPipeline {
+  public:
+    static_assert(Spec.input_channels >= 1 && Spec.input_channels <= kMaxInputChannels);
+    static_assert(Spec.decimation >= 1 && Spec.decimation <= CicDecimator::kMaxFactor);
+
+    static constexpr std::size_t kChannels = Spec.input_channels;
+    static constexpr std::uint32_t kDecimation = Spec.decimation;
+    static constexpr double kBasebandRateHz = Spec.sample_rate_hz / kDecimation;
+    static constexpr bool kButterworth = Spec.filter_design == FilterDesign::Butterworth;
+    static constexpr BiquadCoeffs kLowPass = kButterworth ? design_lowpass(kBasebandRateHz, Spec.lp_cutoff_hz)
+                                                          : design_one_pole_lowpass(kBasebandRateHz, Spec.lp_cutoff_hz);
+    static constexpr BiquadCoeffs kBandHighPass = kButterworth
+                                                      ? design_highpass(kBasebandRateHz, Spec.doppler_band_low_hz)
+                                                      : design_one_pole_highpass(kBasebandRateHz, Spec.doppler_band_low_hz);
+    static constexpr BiquadCoeffs kBandLowPass = kButterworth
+                                                     ? design_lowpass(kBasebandRateHz, Spec.doppler_band_high_hz)
+                                                     : design_one_pole_lowpass(kBasebandRateHz, Spec.doppler_band_high_hz);
+    // Per-sample EMA coefficients, rescaled so time constants do not depend on decimation.
+    static constexpr double kSignalAlpha = 1.0 - cx::pow(0.995, kDecimation);
+    static constexpr double kPhaseAlpha = 1.0 - cx::pow(0.95, kDecimation);
+
+    void begin_session(const AudioConfig& config) override;
+    void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override;
+    [[nodiscard]] RuntimeMetrics metrics() const override {
+        RuntimeMetrics m = metrics_;
+        timer_.fill(m.timing);
+        return m;
+    }
+    [[nodiscard]] RuntimeMetrics latest() const override { return metrics_; }
+    [[nodiscard]] MotionFeatures features() const override { return metrics_.features; }
+    [[nodiscard]] RuntimeMetrics snapshot() const override {
+        RuntimeMetrics m;
+        published_.load().apply_to(m);
+        timer_.fill(m.timing);
+        return m;
+    }
+    [[nodiscard]] const EventJournal* journal() const override { return &journal_; }
+
+  private:
+    static constexpr std::size_t kLanes = 2 * kChannels; // I, Q of channel c at 2c, 2c + 1
+    using Frame = std::array<double, kLanes>;
+
+    // State carried sample to sample, copied to the stack around the fused loop.
+    struct Front {
+        StaticNco<Spec.sample_rate_hz, Spec.f0_hz> nco;
+        StaticCascade<kLanes, kLowPass> low_pass;
+        StaticCascade<kLanes, kBandHighPass, kBandLowPass> band; // Doppler band: strip DC, then limit
+        std::array<double, kChannels> signal_ema{};
+        std::array<double, kChannels> noise_ema{};
+        std::array<double, kChannels> phase_ema{};
+        std::array<double, kChannels> prev_i{}; // last baseband sample, for the phase step
+        std::array<double, kChannels> prev_q{};
+    };
+
+    struct Channel {
+        CicDecimator i_dec{kDecimation}; // unused without decimation
+        CicDecimator q_dec{kDecimation};
+        DopplerSpectrogram spectrogram;
+        MotionFeatures features;
+        float prev_input{0.0F};
+        bool has_prev_input{false};
+    };
+
+    template <typename F>
+    static void for_each_channel(F&& f) {
+        [&]<std::size_t... C>(std::index_sequence<C...>) { (f(C), ...); }(std::make_index_sequence<kChannels>{});
+    }
+
+    // One detector update over at most stride_ frames.
+    void process_update(std::span<const float> input, std::span<float> output, std::size_t frame_offset);
+    void reserve_scratch(std::size_t frames) {
+        if (stride_ >= frames) return;
+        stride_ = frames;
+        for (auto* rows : {&i_rows_, &q_rows_, &step_rows_}) rows->assign(kChannels * stride_, 0.0);
+    }
+
+    AudioConfig config_{};
+    RuntimeMetrics metrics_{};
+    std::size_t total_frames_{0};
+    bool in_session_{false};
+    SineGenerator tx_{Spec.sample_rate_hz, Spec.f0_hz};
+    Front front_;
+    std::array<Channel, kChannels> channels_{};
+    // Mixer output, decimated in place, then the low-passed baseband; one row of stride_ per channel.
+    std::size_t stride_{0};
+    std::vector<double> i_rows_;
+    std::vector<double> q_rows_;
+    std::vector<double> step_rows_;
+
+    CalibrationController calibration_{CalibrationSection{}, DetectionSection{}};
+    DefaultMotionScorer scorer_;
+    DetectionStateMachine fsm_{DetectionSection{}};
+    DefaultActionPolicy action_policy_;
+    ActionSafetyController safety_{DetectionSection{}};
+    EventJournal journal_{LoggingSection{}.journal_capacity};
+    CallbackTimer timer_;
+    Seqlock<MetricsSnapshot> published_;
+};
+
+template <StaticDspSpec Spec>
+void StaticDspPipeline<Spec>::begin_session(const AudioConfig& config) {
+    config_ = config;
+    metrics_ = RuntimeMetrics{};
+    metrics_.sample_rate_hz = Spec.sample_rate_hz;
+    metrics_.frames_per_buffer = config.audio.frames_per_buffer;
+    metrics_.input_channels = kChannels;
+
+    total_frames_ = (config.audio.duration_seconds > 0.0)
+                       ? static_cast<std::size_t>(config.audio.duration_seconds * Spec.sample_rate_hz)
+                       : static_cast<std::size_t>(Spec.sample_rate_hz * 3600.0);
+    tx_.reset();
+    front_ = Front{};
+    front_.signal_ema.fill(1e-6);
+    front_.noise_ema.fill(1e-6);
+    for (auto& ch : channels_) {
+        ch = Channel{};
+        ch.spectrogram.configure(kBasebandRateHz, config);
+    }
+
+    calibration_ = CalibrationController(config.calibration, config.detection);
+    fsm_ = DetectionStateMachine(config.detection);
+    safety_ = ActionSafetyController(config.detection);
+
+    reserve_scratch(std::max<std::size_t>(config.audio.frames_per_buffer, 1));
+    if (journal_.capacity() != config.logging.journal_capacity) journal_ = EventJournal(config.logging.journal_capacity);
+    journal_.clear();
+    journal_.push(JournalRecord{0.0, 0.0F, 0.0F, JournalEventKind::SessionStart});
+    timer_.reset();
+    published_.store(MetricsSnapshot::from(metrics_));
+    in_session_ = true;
+}
+
+template <StaticDspSpec Spec>
+void StaticDspPipeline<Spec>::process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) {
+    if (!in_session_ || input.size() != output.size() * kChannels) return;
+    // Scratch is sized in begin_session; longer callbacks run as stride-sized updates.
+    std::size_t done = 0;
+    do {
+        const std::size_t n = std::min(stride_, output.size() - done);
+        process_update(input.subspan(done * kChannels, n * kChannels), output.subspan(done, n), frame_offset + done);
+        done += n;
+    } while (done < output.size());
+}
+
+template <StaticDspSpec Spec>
+void StaticDspPipeline<Spec>::process_update(std::span<const float> input, std::span<float> output,
+                                             std::size_t frame_offset) {
+    timer_.begin(output.size(), Spec.sample_rate_hz);
+
+    tx_.generate(output, total_frames_, frame_offset);
+
+    const std::size_t frames = output.size();
+    const auto stats = kernels::input_stats(input);
+    const float* in = input.data();
+    double* const i_rows = i_rows_.data();
+    double* const q_rows = q_rows_.data();
+    const std::size_t stride = stride_;
+
+    // Working copy: the row stores could alias members, which would force state reloads.
+    Front st = front_;
+    std::array<float, kChannels> prev_x{};
+    for_each_channel([&](std::size_t c) {
+        prev_x[c] = channels_[c].has_prev_input ? channels_[c].prev_input : (frames > 0 ? in[c] : 0.0F);
+    });
+    std::array<double, kChannels> bb_sum_sq{};
+    std::array<double, kChannels> doppler_sum_sq{};
+
+    // Baseband sample k from mixer output x; edge_frame is the input frame it is emitted at (see
+    // CicDecimator::group_delay for how far its content lags).
+    const auto baseband = [&](std::size_t k, Frame x, std::size_t edge_frame) {
+        constexpr double kEdgeGain = 0.05;
+        st.low_pass.step(x);
+        Frame band = x;
+        st.band.step(band);
+        for_each_channel([&](std::size_t c) {
+            const double ib = x[2 * c];
+            const double qb = x[2 * c + 1];
+            i_rows[c * stride + k] = ib;
+            q_rows[c * stride + k] = qb;
+            const double p = ib * ib + qb * qb;
+            const double mag = std::sqrt(p);
+            bb_sum_sq[c] += p;
+            const double bp_mag = std::sqrt(band[2 * c] * band[2 * c] + band[2 * c + 1] * band[2 * c + 1]);
+            const double before = edge_frame > 0 ? in[(edge_frame - 1) * kChannels + c] : prev_x[c];
+            const double e = bp_mag + kEdgeGain * std::abs(static_cast<double>(in[edge_frame * kChannels + c]) - before);
+            doppler_sum_sq[c] += e * e;
+            st.signal_ema[c] = (1.0 - kSignalAlpha) * st.signal_ema[c] + kSignalAlpha * mag;
+            const double noise = (1.0 - kSignalAlpha) * st.noise_ema[c] + kSignalAlpha * mag;
+            st.noise_ema[c] = bp_mag < 0.01 ? noise : st.noise_ema[c];
+        });
+    };
+
+    std::size_t m = frames;
+    if constexpr (kDecimation == 1) {
+        for (std::size_t k = 0; k < frames; ++k) {
+            const auto [cs, sn] = st.nco.next();
+            Frame x;
+            for_each_channel([&](std::size_t c) {
+                const double v = in[k * kChannels + c];
+                x[2 * c] = v * cs;
+                x[2 * c + 1] = v * -sn;
+            });
+            baseband(k, x, k);
+        }
+    } else {
+        for (std::size_t k = 0; k < frames; ++k) {
+            const auto [cs, sn] = st.nco.next();
+            for_each_channel([&](std::size_t c) {
+                const double v = in[k * kChannels + c];
+                i_rows[c * stride + k] = v * cs;
+                q_rows[c * stride + k] = v * -sn;
+            });
+        }
+        // The decimators of all channels advance in lock step, so m and first_out are shared.
+        std::size_t first_out = 0;
+        for_each_channel([&](std::size_t c) {
+            auto& ch = channels_[c];
+            const std::span<double> i_row(i_rows + c * stride, frames);
+            const std::span<double> q_row(q_rows + c * stride, frames);
+            first_out = ch.i_dec.next_output_offset();
+            m = ch.i_dec.process_block(i_row, i_row);
+            ch.q_dec.process_block(q_row, q_row);
+        });
+        timer_.mark(DspStage::Mix);
+        for (std::size_t j = 0, idx = first_out; j < m; ++j, idx += kDecimation) {
+            Frame x;
+            for_each_channel([&](std::size_t c) {
+                x[2 * c] = i_rows[c * stride + j];
+                x[2 * c + 1] = q_rows[c * stride + j];
+            });
+            baseband(j, x, idx);
+        }
+    }
+
+    // Velocity starts at the second sample of each block, as in BasicDspPipeline.
+    std::array<double, kChannels> phase_vel_sum{};
+    if (m > 0) {
+        for_each_channel([&](std::size_t c) {
+            const std::span<const double> i_bb(i_rows + c * stride, m);
+            const std::span<const double> q_bb(q_rows + c * stride, m);
+            const std::span<double> steps(step_rows_.data() + c * stride, m);
+            kernels::phase_step(i_bb, q_bb, st.prev_i[c], st.prev_q[c], steps);
+            st.prev_i[c] = i_bb.back();
+            st.prev_q[c] = q_bb.back();
+            double ema = st.phase_ema[c];
+            for (std::size_t k = 1; k < m; ++k) {
+                ema = (1.0 - kPhaseAlpha) * ema + kPhaseAlpha * (steps[k] * kBasebandRateHz);
+                phase_vel_sum[c] += std::abs(ema);
+            }
+            st.phase_ema[c] = ema;
+        });
+    }
+    front_ = st;
+
+    // Block statistics over the baseband samples; a block too short to yield one keeps the last values.
+    const bool motion_like = metrics_.latest_event.state == DetectionState::Observing ||
+                             metrics_.latest_event.state == DetectionState::Triggered;
+    const double alpha = motion_like ? config_.dsp.baseline_motion_alpha : config_.dsp.baseline_alpha;
+    const double n = static_cast<double>(m);
+    std::size_t dominant = 0;
+    for_each_channel([&](std::size_t c) {
+        auto& ch = channels_[c];
+        auto& f = ch.features;
+        if (frames > 0) {
+            ch.prev_input = in[(frames - 1) * kChannels + c];
+            ch.has_prev_input = true;
+        }
+        ch.spectrogram.push(std::span<const double>(i_rows + c * stride, m), std::span<const double>(q_rows + c * stride, m));
+
+        const double bb = n > 0.0 ? std::sqrt(bb_sum_sq[c] / n) : f.baseband_energy;
+        const double dop = n > 0.0 ? std::sqrt(doppler_sum_sq[c] / n) : f.doppler_band_energy;
+        f.baseline_energy = (1.0 - alpha) * f.baseline_energy + alpha * dop;
+        f.baseband_energy = bb;
+        f.doppler_band_energy = dop;
+        f.phase_velocity = n > 1.0 ? phase_vel_sum[c] / n : f.phase_velocity;
+        f.snr_estimate = 20.0 * std::log10((front_.signal_ema[c] + 1e-6) / (front_.noise_ema[c] + 1e-6));
+        f.relative_motion = std::max(0.0, dop - f.baseline_energy);
+        ch.spectrogram.fill(f);
+        if (f.relative_motion > channels_[dominant].features.relative_motion) dominant = c;
+    });
+
+    // Fusion: the channel seeing the most motion above its own baseline speaks for the array.
+    metrics_.features = channels_[dominant].features;
+    metrics_.dominant_channel = dominant;
+    metrics_.peak_level = std::max(metrics_.peak_level, stats.peak);
+    const double ns = static_cast<double>(input.size());
+    metrics_.rms_level = ns > 0.0 ? static_cast<float>(std::sqrt(stats.sum_sq / ns)) : 0.0F;
+    metrics_.dc_offset = ns > 0.0 ? static_cast<float>(stats.sum / ns) : 0.0F;
+    metrics_.callbacks += 1;
+    metrics_.frames_processed += frames;
+    timer_.mark(DspStage::Features);
+
+    const double ts = static_cast<double>(frame_offset + frames) / Spec.sample_rate_hz;
+    DetectionSection det_cfg = config_.detection;
+    calibration_.update(ts, metrics_.features.relative_motion, det_cfg, metrics_.latest_event.state);
+    fsm_.set_config(det_cfg);
+    metrics_.trigger_threshold = det_cfg.trigger_threshold;
+    metrics_.release_threshold = det_cfg.release_threshold;
+    metrics_.threshold_updates = calibration_.threshold_updates();
+
+    const double score = scorer_.score(metrics_.features);
+    const auto ev = fsm_.update(score, std::clamp(score, 0.0, 1.0), ts, calibration_.state());
+    if (ev.state == DetectionState::Triggered) metrics_.triggered_count += 1;
+    metrics_.latest_event = ev;
+
+    const auto req = action_policy_.map(ev, config_.actions.mode);
+    metrics_.latest_action = safety_.allow(req, config_.actions.manual_disable, ts) ? req : ActionRequest{};
+    timer_.mark(DspStage::Detect);
+
+    journal_.push(JournalRecord{ts, static_cast<float>(ev.score), static_cast<float>(metrics_.features.relative_motion),
+                                JournalEventKind::Update, ev.state, ev.calibration, metrics_.latest_action.type});
+    published_.store(MetricsSnapshot::from(metrics_));
+    timer_.mark(DspStage::Journal);
+    timer_.end();
+}
+
+// Specs compiled into the library; make_dsp_pipeline() picks the one matching the session config.
+inline constexpr StaticDspSpec kStaticDspDefault{};
+inline constexpr StaticDspSpec kStaticDspButterworth{.filter_design = FilterDesign::Butterworth};
+inline constexpr StaticDspSpec kStaticDspDecimated{.decimation = 32, .filter_design = FilterDesign::Butterworth};
+
+extern template class StaticDspPipeline<kStaticDspDefault>;
+extern template class StaticDspPipeline<kStaticDspButterworth>;
+extern template class StaticDspPipeline<kStaticDspDecimated>;
+
+// Whether one of the compiled-in specs matches config.
+bool has_static_dsp_pipeline(const AudioConfig& config);
+
+// The pipeline for config per dsp.pipeline: Auto and Static take the matching StaticDspPipeline when
+// there is one, Basic (and anything unmatched) gets BasicDspPipeline.
+std::unique_ptr<IDspPipeline> make_dsp_pipeline(const AudioConfig& config);
+
+} // namespace sonarlock::core
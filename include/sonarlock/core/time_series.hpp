@@ -0,0 +1,105 @@
+#pragma once
+
+#include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/mapped_file.hpp"
+#include "sonarlock/core/ring_writer.hpp"
+#include "sonarlock/core/types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+
+namespace sonarlock::core {
+
+// Detector view of one process() call.
+struct SeriesRow {
+    double timestamp_sec{0.0};
+    DetectionState state{DetectionState::Idle};
+    CalibrationState calibration{CalibrationState::Init};
+    ActionType action{ActionType::None};
+    double score{0.0};
+    double confidence{0.0};
+    double trigger_threshold{0.0};
+    double release_threshold{0.0};
+    MotionFeatures features;
+};
+
+enum class SeriesFormat { Csv, Binary };
+
+// Binary series (.slseries), native byte order:
+//   [0, 64)   magic "SLSERIES", u32 byte order mark, u32 version, u32 record bytes, u32 reserved,
+//             f64 sample rate, u64 frames per buffer, zero padded
+//   records   f64 timestamp, f32 score, confidence, trigger and release thresholds, f32 x 11 features
+//             in MotionFeatures order, u8 state, calibration, action, pad
+// A record is kSeriesRecordBytes; a truncated final record is ignored on read.
+inline constexpr std::size_t kSeriesHeaderBytes = 64;
+inline constexpr std::size_t kSeriesRecordBytes = 72;
+inline constexpr std::uint32_t kSeriesVersion = 1;
+
+// .csv selects CSV, anything else the binary encoding.
+SeriesFormat series_format_for(const std::string& path);
+
+// Streams rows to a file. push() runs on the audio thread and only copies the row into a
+// RingWriter. When the ring is full it counts the row as dropped, or with block_when_full waits
+// for the writer; only use that for offline backends, which have no deadline.
+// The writer thread encodes rows with std::to_chars into a reused buffer and writes it in 64 KiB
+// chunks, so memory stays flat for any session length.
+class SeriesWriter {
+  public:
+    SeriesWriter() = default;
+    ~SeriesWriter();
+    SeriesWriter(const SeriesWriter&) = delete;
+    SeriesWriter& operator=(const SeriesWriter&) = delete;
+
+    Status open(const std::string& path, SeriesFormat format, const AudioConfig& config, bool block_when_full = false,
+                std::size_t ring_rows = 4096);
+    void push(const SeriesRow& row);
+    // Drains the ring, writes what is buffered and joins the writer. Reports write failures.
+    Status close();
+
+    [[nodiscard]] bool is_open() const { return file_ != nullptr; }
+    [[nodiscard]] std::uint64_t dropped_rows() const { return ring_.dropped(); }
+    [[nodiscard]] std::uint64_t rows_written() const { return rows_written_; }
+
+  private:
+    bool write_rows(std::span<const SeriesRow> rows);
+    void encode(const SeriesRow& row);
+    bool flush_buffer();
+
+    std::FILE* file_{nullptr};
+    SeriesFormat format_{SeriesFormat::Csv};
+    RingWriter<SeriesRow> ring_;
+    bool block_when_full_{false};
+    // Writer thread; read after close().
+    std::string buffer_;
+    std::uint64_t rows_written_{0};
+};
+
+// Passes everything through to inner and pushes one SeriesRow per process() call.
+class SeriesTap final : public ForwardingPipeline {
+  public:
+    SeriesTap(IDspPipeline& inner, SeriesWriter& writer) : ForwardingPipeline(inner), writer_(writer) {}
+
+    void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override;
+
+  private:
+    SeriesWriter& writer_;
+};
+
+// Memory-mapped binary series. Values come back at float precision, timestamps exactly.
+class SeriesReader {
+  public:
+    Status open(const std::string& path);
+    [[nodiscard]] std::size_t rows() const { return rows_; }
+    [[nodiscard]] double sample_rate_hz() const { return sample_rate_hz_; }
+    [[nodiscard]] SeriesRow row(std::size_t index) const;
+
+  private:
+    MappedFile file_;
+    std::size_t rows_{0};
+    double sample_rate_hz_{0.0};
+};
+
+} // namespace sonarlock::core
@@ -1,26 +1,47 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace sonarlock::core {
 
-enum class BackendKind { Real, Fake };
+enum class BackendKind { Real, Fake, File };
 enum class FakeScenario { Static, Human, Pet, Vibration };
 enum class SessionState { Idle, Running, Stopped, Error };
 enum class DetectionState { Idle, Observing, Triggered, Cooldown };
 enum class CalibrationState { Init, Warmup, Calibrating, Armed };
 enum class ActionMode { Soft, Lock, Notify };
 enum class ActionType { None, Beep, LockScreen, Notify };
+// OnePole reproduces the original first-order chain; Butterworth uses second-order sections.
+enum class FilterDesign { OnePole, Butterworth };
+// Basic (the default) is the runtime-configured pipeline. Auto uses a compile-time StaticDspPipeline
+// when one matches the audio/dsp settings, else Basic; Static requires a match.
+enum class DspPipelineKind { Auto, Basic, Static };
+enum class LogOverflowPolicy { Drop, Block };
+
+inline constexpr std::size_t kMaxInputChannels = 8;
 
 struct AudioSection {
     double sample_rate_hz{48000.0};
     std::size_t frames_per_buffer{256};
     double duration_seconds{5.0}; // 0 => run until stop requested
     double f0_hz{19000.0};
+    // Capture channels (1..kMaxInputChannels). Input buffers are interleaved frame by frame; TX stays mono.
+    std::size_t input_channels{1};
+    // File backend: WAV (PCM16/PCM24/float32) or headerless float32 at sample_rate_hz / input_channels.
+    std::string input_path;
+    // Capture tap: record the input (and with record_tx the TX output, to "<stem>.tx.wav") as
+    // float32 WAV. The ring holds record_ring_blocks buffers; blocks are dropped when it is full.
+    std::string record_path;
+    bool record_tx{false};
+    std::size_t record_ring_blocks{256};
+    bool decoupled_dsp{false};   // real backend: run DSP on a worker fed by SPSC rings
+    std::size_t ring_blocks{16}; // ring capacity in frames_per_buffer blocks
 };
 
 struct DspSection {
@@ -29,6 +50,16 @@ struct DspSection {
     double doppler_band_high_hz{200.0};
     double baseline_alpha{0.004};
     double baseline_motion_alpha{0.0004};
+    // Baseband decimation after the I/Q mixer (CIC + compensation FIR). 1 keeps every stage at the
+    // audio rate; 32 runs everything after the mixer at 1.5 kHz for a 48 kHz stream.
+    std::uint32_t decimation{1};
+    FilterDesign filter_design{FilterDesign::OnePole};
+    // STFT Doppler spectrum over the baseband: power-of-two frame size (0 disables), hop, and the
+    // rate the baseband is averaged down to first.
+    std::size_t stft_size{64};
+    std::size_t stft_hop{32};
+    double stft_rate_hz{800.0};
+    DspPipelineKind pipeline{DspPipelineKind::Basic};
 };
 
 struct CalibrationSection {
@@ -39,6 +70,12 @@ struct CalibrationSection {
     double release_k{4.0};
     double min_threshold{0.20};
     double max_threshold{0.95};
+    // Online adaptation once Armed: noise stats keep updating while the detector is Idle and
+    // thresholds move towards the new estimate by at most adapt_max_step per interval.
+    bool adapt{false};
+    double adapt_interval_seconds{5.0};
+    double adapt_window_seconds{300.0}; // decay time constant of the noise statistics
+    double adapt_max_step{0.02};
 };
 
 struct DetectionSection {
@@ -60,6 +97,14 @@ struct LoggingSection {
     std::string file_path{"sonarlock.log"};
     std::size_t rotate_size_bytes{1024 * 1024};
     std::uint32_t rotate_count{3};
+    std::size_t journal_capacity{200}; // events kept in memory for dump-events (~24 bytes each)
+    std::size_t queue_capacity{1024};  // pending log messages before overflow applies
+    LogOverflowPolicy overflow{LogOverflowPolicy::Drop};
+    bool console{true}; // also write log lines to stdout
+    std::string feature_trace_path; // run/analyze: columnar per-callback features for `replay`
+    std::string series_path;        // run/analyze: one row per callback; .csv or compact binary
+    std::string metrics_path;       // run/analyze: Prometheus text file rewritten during the session
+    std::uint32_t metrics_interval_ms{1000};
 };
 
 struct AppConfig {
@@ -91,8 +136,21 @@ struct MotionFeatures {
     double snr_estimate{0.0};
     double baseline_energy{0.0};
     double relative_motion{0.0};
+    // From the latest STFT frame (DspSection::stft_*); 0 until the first frame completes.
+    double doppler_peak_hz{0.0};     // signed; positive = approaching
+    double radial_velocity_mps{0.0}; // doppler_peak_hz * c / (2 f0)
+    double doppler_spread_hz{0.0};   // power-weighted spread inside the Doppler band
+    double approach_energy{0.0};     // band power at positive Doppler
+    double recede_energy{0.0};       // band power at negative Doppler
 };
 
+// Every MotionFeatures field in declaration order; also the column order of traces and series files.
+inline constexpr std::array<double MotionFeatures::*, 11> kFeatureFields = {
+    &MotionFeatures::baseband_energy,  &MotionFeatures::doppler_band_energy, &MotionFeatures::phase_velocity,
+    &MotionFeatures::snr_estimate,     &MotionFeatures::baseline_energy,     &MotionFeatures::relative_motion,
+    &MotionFeatures::doppler_peak_hz,  &MotionFeatures::radial_velocity_mps, &MotionFeatures::doppler_spread_hz,
+    &MotionFeatures::approach_energy,  &MotionFeatures::recede_energy};
+
 struct MotionEvent {
     DetectionState state{DetectionState::Idle};
     CalibrationState calibration{CalibrationState::Init};
@@ -104,7 +162,30 @@ struct MotionEvent {
 struct ActionRequest {
     ActionType type{ActionType::None};
     double timestamp_sec{0.0};
-    std::string reason;
+    std::string_view reason; // static storage only; keeps ActionRequest allocation-free
+};
+
+// Stages of BasicDspPipeline::process timed by CallbackTiming::stage_mean_us.
+enum class DspStage { Mix, Filter, Features, Detect, Journal };
+inline constexpr std::size_t kDspStages = 5;
+
+// Time spent in IDspPipeline::process against the buffer period (frames / sample_rate_hz).
+// Percentiles come from log-linear histograms and are within 1/16 of the exact value. Jitter is
+// |time between callback starts - period|; it only means something with a real-time backend,
+// since the fake and file backends call back-to-back.
+struct CallbackTiming {
+    std::uint64_t deadline_misses{0}; // callbacks whose compute time exceeded their period
+    double period_us{0.0};            // longest buffer seen, normally frames_per_buffer / sample_rate_hz
+    double compute_mean_us{0.0};
+    double compute_p50_us{0.0};
+    double compute_p99_us{0.0};
+    double compute_max_us{0.0};
+    double min_headroom_us{0.0}; // smallest period - compute; negative once a deadline was missed
+    double jitter_p99_us{0.0};
+    double jitter_max_us{0.0};
+    // Indexed by DspStage. NaN for stages the pipeline does not time on their own (StaticDspPipeline
+    // fuses mix and filter into features); their time is counted in the next stage that is timed.
+    std::array<double, kDspStages> stage_mean_us{};
 };
 
 struct RuntimeMetrics {
@@ -116,11 +197,25 @@ struct RuntimeMetrics {
     std::uint64_t xruns{0};
     std::uint64_t callbacks{0};
     std::uint64_t frames_processed{0};
+    std::uint64_t callback_allocations{0}; // SONARLOCK_AUDIT_ALLOCATIONS builds only
+    std::uint64_t ring_overruns{0};        // decoupled mode: input blocks dropped, DSP fell behind
+    std::uint64_t ring_underruns{0};       // decoupled mode: output blocks padded with silence
+    std::size_t rx_ring_high_water{0};     // frames
+    std::size_t tx_ring_high_water{0};     // frames
+    std::size_t input_channels{1};
+    std::size_t dominant_channel{0}; // channel whose features drove the latest detection update
+    double realtime_factor{0.0};     // fake/file backends: audio seconds processed per wall-clock second
+    std::uint64_t recorded_frames{0};        // capture tap
+    std::uint64_t record_dropped_blocks{0};  // capture tap: blocks lost because the writer fell behind
 
     MotionFeatures features{};
     MotionEvent latest_event{};
     ActionRequest latest_action{};
     std::uint64_t triggered_count{0};
+    double trigger_threshold{0.0}; // thresholds the detector is currently using
+    double release_threshold{0.0};
+    std::uint64_t threshold_updates{0}; // online adaptation steps since Armed
+    CallbackTiming timing{};
 };
 
 struct Status {
@@ -135,5 +230,7 @@ constexpr int kErrInvalidArgument = 2;
 constexpr int kErrBackendUnavailable = 3;
 constexpr int kErrAudioDeviceUnavailable = 4;
 constexpr int kErrStreamFailure = 5;
+constexpr int kErrInputFile = 6; // unreadable or unsupported input file
+constexpr int kErrCancelled = 7;  // batch job skipped after BatchEngine::cancel()
 
 } // namespace sonarlock::core
@@ -1,8 +1,10 @@
 #include "sonarlock/app/cli.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <regex>
 #include <type_traits>
+#include <vector>
 
 namespace sonarlock::app {
 
@@ -20,6 +22,40 @@ core::Status parse_num(const std::string& value, T& out) {
     return core::Status::success();
 }
 
+// "first:last:step" (inclusive), "a,b,c" or a single value.
+template <typename T>
+core::Status parse_range(const std::string& value, std::vector<T>& out) {
+    out.clear();
+    const auto first_colon = value.find(':');
+    if (first_colon == std::string::npos) {
+        std::size_t start = 0;
+        while (start <= value.size()) {
+            const auto comma = std::min(value.find(',', start), value.size());
+            T v{};
+            if (auto st = parse_num(value.substr(start, comma - start), v); !st.ok()) return st;
+            out.push_back(v);
+            start = comma + 1;
+        }
+        return core::Status::success();
+    }
+    const auto second_colon = value.find(':', first_colon + 1);
+    double first = 0.0;
+    double last = 0.0;
+    double step = 0.0;
+    if (second_colon == std::string::npos || !parse_num(value.substr(0, first_colon), first).ok() ||
+        !parse_num(value.substr(first_colon + 1, second_colon - first_colon - 1), last).ok() ||
+        !parse_num(value.substr(second_colon + 1), step).ok() || step <= 0.0 || last < first) {
+        return core::Status::error(core::kErrInvalidArgument, "bad range (first:last:step): " + value);
+    }
+    const auto n = static_cast<std::size_t>((last - first) / step + 1e-9) + 1;
+    for (std::size_t k = 0; k < n; ++k) {
+        const double v = first + static_cast<double>(k) * step;
+        if constexpr (std::is_integral_v<T>) out.push_back(static_cast<T>(v + 0.5));
+        else out.push_back(v);
+    }
+    return core::Status::success();
+}
+
 std::string find_json_string(const std::string& text, const std::string& key) {
     std::regex r("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
     std::smatch m;
@@ -34,6 +70,13 @@ double find_json_number(const std::string& text, const std::string& key, double
     return def;
 }
 
+bool find_json_bool(const std::string& text, const std::string& key, bool def) {
+    std::regex r("\"" + key + "\"\\s*:\\s*(true|false)");
+    std::smatch m;
+    if (std::regex_search(text, m, r)) return m[1] == "true";
+    return def;
+}
+
 } // namespace
 
 core::Status load_config_file(const std::string& path, core::AudioConfig& cfg) {
@@ -46,14 +89,49 @@ core::Status load_config_file(const std::string& path, core::AudioConfig& cfg) {
     cfg.audio.frames_per_buffer = static_cast<std::size_t>(find_json_number(text, "frames_per_buffer", static_cast<double>(cfg.audio.frames_per_buffer)));
     cfg.audio.duration_seconds = find_json_number(text, "duration_seconds", cfg.audio.duration_seconds);
     cfg.audio.f0_hz = find_json_number(text, "f0_hz", cfg.audio.f0_hz);
+    cfg.audio.input_channels = static_cast<std::size_t>(find_json_number(text, "input_channels", static_cast<double>(cfg.audio.input_channels)));
+    cfg.audio.decoupled_dsp = find_json_bool(text, "decoupled_dsp", cfg.audio.decoupled_dsp);
+    cfg.audio.record_tx = find_json_bool(text, "record_tx", cfg.audio.record_tx);
+    cfg.audio.record_ring_blocks = static_cast<std::size_t>(find_json_number(text, "record_ring_blocks", static_cast<double>(cfg.audio.record_ring_blocks)));
+    cfg.audio.ring_blocks = static_cast<std::size_t>(find_json_number(text, "ring_blocks", static_cast<double>(cfg.audio.ring_blocks)));
     cfg.dsp.lp_cutoff_hz = find_json_number(text, "lp_cutoff_hz", cfg.dsp.lp_cutoff_hz);
     cfg.dsp.doppler_band_low_hz = find_json_number(text, "doppler_band_low_hz", cfg.dsp.doppler_band_low_hz);
     cfg.dsp.doppler_band_high_hz = find_json_number(text, "doppler_band_high_hz", cfg.dsp.doppler_band_high_hz);
+    cfg.dsp.decimation = static_cast<std::uint32_t>(find_json_number(text, "decimation", cfg.dsp.decimation));
+    cfg.dsp.stft_size = static_cast<std::size_t>(find_json_number(text, "stft_size", static_cast<double>(cfg.dsp.stft_size)));
+    cfg.dsp.stft_hop = static_cast<std::size_t>(find_json_number(text, "stft_hop", static_cast<double>(cfg.dsp.stft_hop)));
+    cfg.dsp.stft_rate_hz = find_json_number(text, "stft_rate_hz", cfg.dsp.stft_rate_hz);
+    cfg.logging.console = find_json_bool(text, "log_console", cfg.logging.console);
+    cfg.logging.journal_capacity = static_cast<std::size_t>(find_json_number(text, "journal_capacity", static_cast<double>(cfg.logging.journal_capacity)));
+    cfg.logging.metrics_interval_ms = static_cast<std::uint32_t>(find_json_number(text, "metrics_interval_ms", cfg.logging.metrics_interval_ms));
+    cfg.calibration.adapt = find_json_bool(text, "adapt_thresholds", cfg.calibration.adapt);
+    cfg.calibration.adapt_interval_seconds = find_json_number(text, "adapt_interval_seconds", cfg.calibration.adapt_interval_seconds);
+    cfg.calibration.adapt_window_seconds = find_json_number(text, "adapt_window_seconds", cfg.calibration.adapt_window_seconds);
+    cfg.calibration.adapt_max_step = find_json_number(text, "adapt_max_step", cfg.calibration.adapt_max_step);
     cfg.detection.trigger_threshold = find_json_number(text, "trigger_threshold", cfg.detection.trigger_threshold);
     cfg.detection.release_threshold = find_json_number(text, "release_threshold", cfg.detection.release_threshold);
     cfg.detection.debounce_ms = static_cast<std::uint32_t>(find_json_number(text, "debounce_ms", cfg.detection.debounce_ms));
     cfg.detection.cooldown_ms = static_cast<std::uint32_t>(find_json_number(text, "cooldown_ms", cfg.detection.cooldown_ms));
 
+    if (const auto input = find_json_string(text, "input_path"); !input.empty()) cfg.audio.input_path = input;
+    if (const auto record = find_json_string(text, "record_path"); !record.empty()) cfg.audio.record_path = record;
+    if (const auto trace = find_json_string(text, "feature_trace_path"); !trace.empty()) cfg.logging.feature_trace_path = trace;
+    if (const auto series = find_json_string(text, "series_path"); !series.empty()) cfg.logging.series_path = series;
+    if (const auto metrics = find_json_string(text, "metrics_path"); !metrics.empty()) cfg.logging.metrics_path = metrics;
+
+    const auto filter = find_json_string(text, "filter_design");
+    if (filter == "butterworth") cfg.dsp.filter_design = core::FilterDesign::Butterworth;
+    else if (filter == "onepole") cfg.dsp.filter_design = core::FilterDesign::OnePole;
+
+    const auto pipeline = find_json_string(text, "pipeline");
+    if (pipeline == "auto") cfg.dsp.pipeline = core::DspPipelineKind::Auto;
+    else if (pipeline == "basic") cfg.dsp.pipeline = core::DspPipelineKind::Basic;
+    else if (pipeline == "static") cfg.dsp.pipeline = core::DspPipelineKind::Static;
+
+    const auto overflow = find_json_string(text, "log_overflow");
+    if (overflow == "block") cfg.logging.overflow = core::LogOverflowPolicy::Block;
+    else if (overflow == "drop") cfg.logging.overflow = core::LogOverflowPolicy::Drop;
+
     const auto mode = find_json_string(text, "action_mode");
     if (mode == "lock") cfg.actions.mode = core::ActionMode::Lock;
     else if (mode == "notify") cfg.actions.mode = core::ActionMode::Notify;
@@ -70,6 +148,7 @@ core::Status parse_args(const std::vector<std::string>& args, CommandLine& out)
     else if (args[0] == "analyze") out.kind = CommandKind::Analyze;
     else if (args[0] == "calibrate") out.kind = CommandKind::Calibrate;
     else if (args[0] == "dump-events") out.kind = CommandKind::DumpEvents;
+    else if (args[0] == "replay") out.kind = CommandKind::Replay;
     else return core::Status::error(core::kErrInvalidArgument, "unknown command: " + args[0]);
 
     for (std::size_t i = 1; i < args.size(); ++i) {
@@ -77,19 +156,58 @@ core::Status parse_args(const std::vector<std::string>& args, CommandLine& out)
         auto take = [&]() -> core::Status { if (i + 1 >= args.size()) return core::Status::error(core::kErrInvalidArgument, "missing value for " + t); ++i; return core::Status::success(); };
         core::Status st;
 
+        if (out.kind == CommandKind::Replay && out.replay_path.empty() && t.rfind("--", 0) != 0) { out.replay_path = t; continue; }
+
         if (t == "--config") { if (!(st = take()).ok()) return st; out.config_path = args[i]; }
         else if (t == "--duration") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.duration_seconds)).ok()) return st; }
         else if (t == "--f0" || t == "--freq") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.f0_hz)).ok()) return st; }
         else if (t == "--samplerate") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.sample_rate_hz)).ok()) return st; }
         else if (t == "--frames") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.frames_per_buffer)).ok()) return st; }
+        else if (t == "--channels") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.input_channels)).ok()) return st; }
+        else if (t == "--decoupled-dsp") { out.config.audio.decoupled_dsp = true; }
+        else if (t == "--record") { if (!(st = take()).ok()) return st; out.config.audio.record_path = args[i]; }
+        else if (t == "--record-tx") { out.config.audio.record_tx = true; }
+        else if (t == "--ring-blocks") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.audio.ring_blocks)).ok()) return st; }
         else if (t == "--lp-cutoff") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.lp_cutoff_hz)).ok()) return st; }
         else if (t == "--band-low") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.doppler_band_low_hz)).ok()) return st; }
+        else if (t == "--decimation") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.decimation)).ok()) return st; }
+        else if (t == "--filter") {
+            if (!(st = take()).ok()) return st;
+            if (args[i] == "onepole") out.config.dsp.filter_design = core::FilterDesign::OnePole;
+            else if (args[i] == "butterworth") out.config.dsp.filter_design = core::FilterDesign::Butterworth;
+            else return core::Status::error(core::kErrInvalidArgument, "invalid filter design");
+        }
+        else if (t == "--pipeline") {
+            if (!(st = take()).ok()) return st;
+            if (args[i] == "auto") out.config.dsp.pipeline = core::DspPipelineKind::Auto;
+            else if (args[i] == "basic") out.config.dsp.pipeline = core::DspPipelineKind::Basic;
+            else if (args[i] == "static") out.config.dsp.pipeline = core::DspPipelineKind::Static;
+            else return core::Status::error(core::kErrInvalidArgument, "invalid pipeline");
+        }
+        else if (t == "--stft-size") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.stft_size)).ok()) return st; }
+        else if (t == "--stft-hop") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.stft_hop)).ok()) return st; }
         else if (t == "--band-high") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.dsp.doppler_band_high_hz)).ok()) return st; }
         else if (t == "--trigger-th") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.detection.trigger_threshold)).ok()) return st; }
         else if (t == "--release-th") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.detection.release_threshold)).ok()) return st; }
         else if (t == "--debounce-ms") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.detection.debounce_ms)).ok()) return st; }
         else if (t == "--cooldown-ms") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.detection.cooldown_ms)).ok()) return st; }
-        else if (t == "--backend") { if (!(st = take()).ok()) return st; out.backend = (args[i] == "real") ? core::BackendKind::Real : core::BackendKind::Fake; }
+        else if (t == "--sweep") { out.sweep = true; }
+        else if (t == "--sweep-trigger-th") { out.sweep = true; if (!(st = take()).ok() || !(st = parse_range(args[i], out.sweep_grid.trigger_threshold)).ok()) return st; }
+        else if (t == "--sweep-release-th") { out.sweep = true; if (!(st = take()).ok() || !(st = parse_range(args[i], out.sweep_grid.release_threshold)).ok()) return st; }
+        else if (t == "--sweep-debounce-ms") { out.sweep = true; if (!(st = take()).ok() || !(st = parse_range(args[i], out.sweep_grid.debounce_ms)).ok()) return st; }
+        else if (t == "--sweep-cooldown-ms") { out.sweep = true; if (!(st = take()).ok() || !(st = parse_range(args[i], out.sweep_grid.cooldown_ms)).ok()) return st; }
+        else if (t == "--sweep-motion") {
+            std::vector<double> window;
+            if (!(st = take()).ok() || !(st = parse_range(args[i], window)).ok()) return st;
+            if (window.size() != 2 || window[0] < 0.0 || window[1] < window[0]) return core::Status::error(core::kErrInvalidArgument, "--sweep-motion expects start,end");
+            out.sweep_motion_start = window[0];
+            out.sweep_motion_end = window[1];
+        }
+        else if (t == "--backend") {
+            if (!(st = take()).ok()) return st;
+            out.backend = (args[i] == "real") ? core::BackendKind::Real : (args[i] == "file") ? core::BackendKind::File : core::BackendKind::Fake;
+        }
+        else if (t == "--input") { if (!(st = take()).ok()) return st; out.config.audio.input_path = args[i]; out.backend = core::BackendKind::File; }
         else if (t == "--scenario") {
             if (!(st = take()).ok()) return st;
             if (args[i] == "static") out.config.scenario = core::FakeScenario::Static;
@@ -99,9 +217,23 @@ core::Status parse_args(const std::vector<std::string>& args, CommandLine& out)
             else return core::Status::error(core::kErrInvalidArgument, "invalid scenario");
         } else if (t == "--csv") { if (!(st = take()).ok()) return st; out.csv_path = args[i]; }
         else if (t == "--json") { out.json_output = true; }
+        else if (t == "--feature-trace") { if (!(st = take()).ok()) return st; out.config.logging.feature_trace_path = args[i]; }
+        else if (t == "--series") { if (!(st = take()).ok()) return st; out.config.logging.series_path = args[i]; }
+        else if (t == "--metrics-file") { if (!(st = take()).ok()) return st; out.config.logging.metrics_path = args[i]; }
+        else if (t == "--metrics-interval-ms") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.logging.metrics_interval_ms)).ok()) return st; }
+        else if (t == "--journal-capacity") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.logging.journal_capacity)).ok()) return st; }
+        else if (t == "--log-overflow") {
+            if (!(st = take()).ok()) return st;
+            if (args[i] == "drop") out.config.logging.overflow = core::LogOverflowPolicy::Drop;
+            else if (args[i] == "block") out.config.logging.overflow = core::LogOverflowPolicy::Block;
+            else return core::Status::error(core::kErrInvalidArgument, "invalid log overflow policy");
+        }
         else if (t == "--dump-count") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.dump_count)).ok()) return st; }
         else if (t == "--daemon") { out.config.daemon_mode = true; }
         else if (t == "--no-calibration") { out.config.calibration.enabled = false; }
+        else if (t == "--adapt-thresholds") { out.config.calibration.adapt = true; }
+        else if (t == "--adapt-interval") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.calibration.adapt_interval_seconds)).ok()) return st; }
+        else if (t == "--adapt-max-step") { if (!(st = take()).ok() || !(st = parse_num(args[i], out.config.calibration.adapt_max_step)).ok()) return st; }
         else if (t == "--disable-actions") { out.config.actions.manual_disable = true; }
         else if (t == "--action") {
             if (!(st = take()).ok()) return st;
@@ -111,6 +243,8 @@ core::Status parse_args(const std::vector<std::string>& args, CommandLine& out)
         }
         else return core::Status::error(core::kErrInvalidArgument, "unknown option: " + t);
     }
+    if (out.kind == CommandKind::Replay && out.replay_path.empty()) return core::Status::error(core::kErrInvalidArgument, "replay needs a trace file");
+    if (out.sweep && out.kind != CommandKind::Analyze) return core::Status::error(core::kErrInvalidArgument, "--sweep is only valid with analyze");
     return core::Status::success();
 }
 
@@ -1,13 +1,21 @@
 #include "sonarlock/app/cli.hpp"
 
 #include "sonarlock/audio/audio_factory.hpp"
+#include "sonarlock/audio/fake_audio_backend.hpp"
 #include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/feature_trace.hpp"
 #include "sonarlock/core/logger.hpp"
+#include "sonarlock/core/metrics_export.hpp"
+#include "sonarlock/core/parameter_sweep.hpp"
 #include "sonarlock/core/session_controller.hpp"
+#include "sonarlock/core/static_dsp_pipeline.hpp"
+#include "sonarlock/core/time_series.hpp"
 #include "sonarlock/platform/action_executor.hpp"
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <csignal>
 #include <cstdlib>
 #include <filesystem>
@@ -26,7 +34,7 @@ const char* state_name(sonarlock::core::DetectionState s) {
 }
 
 void print_help() {
-    std::cout << "Usage:\n  sonarlock devices\n  sonarlock calibrate|run|analyze [--backend real|fake] [--config path] ...\n  sonarlock dump-events [--dump-count N]\n";
+    std::cout << "Usage:\n  sonarlock devices\n  sonarlock calibrate|run|analyze [--backend real|fake|file] [--input file.wav] [--config path] ...\n  sonarlock analyze --sweep [--sweep-trigger-th 0.3:0.8:0.05] [--sweep-debounce-ms 100,300] ...\n  sonarlock replay trace.sltrace [--trigger-th X ...]\n  sonarlock dump-events [--dump-count N]\n";
 }
 
 std::string default_config_path() {
@@ -39,6 +47,126 @@ std::string default_config_path() {
 #endif
 }
 
+// analyze --sweep: one DSP pass per fake scenario (or the input file) records the feature stream, then the
+// detection grid is replayed over it.
+int run_sweep(const sonarlock::app::CommandLine& cmd) {
+    using namespace sonarlock;
+    using Clock = std::chrono::steady_clock;
+    if (cmd.backend == core::BackendKind::Real) {
+        core::log(core::LogLevel::Error, "--sweep needs --backend fake or --input");
+        return core::kErrInvalidArgument;
+    }
+    auto config = cmd.config;
+    config.actions.manual_disable = true;
+    config.audio.record_path.clear();
+
+    const auto capture = [](core::IAudioBackend& backend, const core::AudioConfig& cfg, core::FeatureTrace& trace) {
+        const auto pipeline = core::make_dsp_pipeline(cfg);
+        core::FeatureRecorder recorder;
+        core::FeatureTap tap(*pipeline, recorder);
+        core::RuntimeMetrics m;
+        const auto st = backend.run_session(cfg, tap, m, [] { return g_stop.load(); });
+        recorder.take(trace);
+        return st;
+    };
+
+    const auto t0 = Clock::now();
+    std::vector<core::FeatureTrace> traces;
+    if (cmd.backend == core::BackendKind::File) {
+        core::FeatureTrace trace{config.audio.input_path, {}, cmd.sweep_motion_start, cmd.sweep_motion_end};
+        auto backend = audio::make_backend(core::BackendKind::File, config.scenario, config.seed);
+        if (const auto st = capture(*backend, config, trace); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+        traces.push_back(std::move(trace));
+    } else {
+        // Long enough for calibration to arm well before the human scenario's motion starts.
+        auto& duration = config.audio.duration_seconds;
+        if (duration <= 0.0) duration = 60.0;
+        if (config.calibration.enabled) duration = std::max(duration, config.calibration.warmup_seconds + config.calibration.calibrate_seconds + 4.0);
+        const std::pair<const char*, core::FakeScenario> scenarios[] = {{"static", core::FakeScenario::Static}, {"human", core::FakeScenario::Human},
+                                                                        {"pet", core::FakeScenario::Pet}, {"vibration", core::FakeScenario::Vibration}};
+        for (const auto& [name, scenario] : scenarios) {
+            auto cfg = config;
+            cfg.scenario = scenario;
+            const auto [start, end] = audio::FakeAudioBackend::motion_window(scenario, duration);
+            core::FeatureTrace trace{name, {}, start, end};
+            audio::FakeAudioBackend backend(scenario, cfg.seed);
+            if (const auto st = capture(backend, cfg, trace); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+            traces.push_back(std::move(trace));
+        }
+    }
+
+    const auto t1 = Clock::now();
+    auto grid_spec = cmd.sweep_grid;
+    if (grid_spec.empty()) {
+        grid_spec.trigger_threshold = {0.30, 0.35, 0.40, 0.45, 0.50, 0.55, 0.60, 0.65, 0.70, 0.75, 0.80};
+        grid_spec.debounce_ms = {100, 200, 300, 400, 500};
+    }
+    const auto grid = core::expand_grid(config.detection, grid_spec);
+    const auto results = core::run_sweep(traces, grid, config.calibration);
+    const auto t2 = Clock::now();
+
+    std::ostringstream table;
+    std::ostringstream csv;
+    table << "trigger_th release_th debounce_ms cooldown_ms triggers false_triggers detected latency_ms\n";
+    csv << "trigger_th,release_th,debounce_ms,cooldown_ms,triggers,false_triggers,detected,motion_traces,latency_ms\n";
+    const core::SweepResult* best = nullptr;
+    const auto better = [](const core::SweepResult& a, const core::SweepResult& b) {
+        if (a.false_triggers != b.false_triggers) return a.false_triggers < b.false_triggers;
+        if (a.detected != b.detected) return a.detected > b.detected;
+        return a.mean_latency_sec >= 0.0 && (b.mean_latency_sec < 0.0 || a.mean_latency_sec < b.mean_latency_sec);
+    };
+    for (const auto& r : results) {
+        const auto& d = r.detection;
+        const double latency_ms = r.mean_latency_sec >= 0.0 ? r.mean_latency_sec * 1000.0 : -1.0;
+        table << d.trigger_threshold << ' ' << d.release_threshold << ' ' << d.debounce_ms << ' ' << d.cooldown_ms << ' '
+              << r.triggers << ' ' << r.false_triggers << ' ' << r.detected << '/' << r.motion_traces << ' ' << latency_ms << '\n';
+        csv << d.trigger_threshold << ',' << d.release_threshold << ',' << d.debounce_ms << ',' << d.cooldown_ms << ','
+            << r.triggers << ',' << r.false_triggers << ',' << r.detected << ',' << r.motion_traces << ',' << latency_ms << '\n';
+        if (!best || better(r, *best)) best = &r;
+    }
+    std::cout << table.str();
+    if (!cmd.csv_path.empty()) std::ofstream(cmd.csv_path) << csv.str();
+
+    std::ostringstream ss;
+    ss << "sweep points=" << results.size() << " traces=" << traces.size()
+       << " dsp_seconds=" << std::chrono::duration<double>(t1 - t0).count()
+       << " sweep_seconds=" << std::chrono::duration<double>(t2 - t1).count();
+    if (best) {
+        ss << " best: trigger_th=" << best->detection.trigger_threshold << " release_th=" << best->detection.release_threshold
+           << " debounce_ms=" << best->detection.debounce_ms << " cooldown_ms=" << best->detection.cooldown_ms
+           << " false_triggers=" << best->false_triggers << " detected=" << best->detected << '/' << best->motion_traces;
+    }
+    core::log(core::LogLevel::Info, ss.str());
+    core::flush_log();
+    return 0;
+}
+
+// replay <trace>: the trace header supplies the config, command-line flags override it. Actions are
+// only counted, never executed.
+int run_replay(const sonarlock::app::CommandLine& cmd, const std::vector<std::string>& args) {
+    using namespace sonarlock;
+    core::FeatureTraceReader trace;
+    if (const auto st = trace.open(cmd.replay_path); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+    app::CommandLine replay = cmd;
+    trace.header().apply_to(replay.config);
+    replay.replay_path.clear();
+    if (const auto st = app::parse_args(args, replay); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = core::replay_trace(trace, replay.config);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto& m = result.metrics;
+    std::ostringstream ss;
+    ss << "replay rows=" << trace.rows() << " rows_per_second=" << (wall > 0.0 ? static_cast<double>(trace.rows()) / wall : 0.0)
+       << " state=" << state_name(m.latest_event.state) << " cal=" << static_cast<int>(m.latest_event.calibration)
+       << " trigger_th=" << m.trigger_threshold << " release_th=" << m.release_threshold
+       << " threshold_updates=" << m.threshold_updates << " triggers=" << m.triggered_count << " actions=" << result.actions;
+    core::log(core::LogLevel::Info, ss.str());
+    core::flush_log();
+    return 0;
+}
+
 std::string extract_config_path(const std::vector<std::string>& args) {
     for (std::size_t i = 0; i + 1 < args.size(); ++i) if (args[i] == "--config") return args[i + 1];
     return {};
@@ -71,6 +199,13 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    if (cmd.config.dsp.pipeline == core::DspPipelineKind::Static && !core::has_static_dsp_pipeline(cmd.config)) {
+        core::log(core::LogLevel::Error, "--pipeline static: no compiled-in static pipeline matches the audio/dsp settings");
+        return core::kErrInvalidArgument;
+    }
+    if (cmd.sweep) return run_sweep(cmd);
+    if (cmd.kind == app::CommandKind::Replay) return run_replay(cmd, args);
+
     auto backend = audio::make_backend(cmd.backend, cmd.config.scenario, cmd.config.seed);
     if (cmd.kind == app::CommandKind::Devices) {
         const auto devices = backend->enumerate_devices();
@@ -84,10 +219,35 @@ int main(int argc, char** argv) {
         cmd.config.audio.duration_seconds = std::max(10.0, cmd.config.calibration.warmup_seconds + cmd.config.calibration.calibrate_seconds + 1.0);
     }
 
-    core::BasicDspPipeline pipeline;
+    const auto pipeline = core::make_dsp_pipeline(cmd.config);
     core::SessionController controller(*backend);
     core::RuntimeMetrics metrics;
-    const auto status = controller.run(cmd.config, pipeline, metrics, [] { return g_stop.load(); });
+    core::FeatureTraceWriter trace;
+    core::FeatureTap traced(*pipeline, trace);
+    const auto& trace_path = cmd.config.logging.feature_trace_path;
+    if (!trace_path.empty()) {
+        if (const auto st = trace.open(trace_path, cmd.config); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+    }
+    core::IDspPipeline& traced_or_plain = trace_path.empty() ? *pipeline : traced;
+    core::SeriesWriter series;
+    core::SeriesTap series_tap(traced_or_plain, series);
+    const auto& series_path = cmd.config.logging.series_path;
+    if (!series_path.empty()) {
+        // Offline backends have no deadline, so they wait for the writer instead of dropping rows.
+        const bool block = cmd.backend != core::BackendKind::Real;
+        if (const auto st = series.open(series_path, core::series_format_for(series_path), cmd.config, block); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+    }
+    core::IDspPipeline& active = series_path.empty() ? traced_or_plain : series_tap;
+    core::MetricsExporter exporter;
+    if (const auto& path = cmd.config.logging.metrics_path; !path.empty()) {
+        if (const auto st = exporter.start(active, path, cmd.config.logging.metrics_interval_ms); !st.ok()) { core::log(core::LogLevel::Error, st.message); return st.code; }
+    }
+    auto status = controller.run(cmd.config, active, metrics, [] { return g_stop.load(); });
+    exporter.stop();
+    if (const auto st = trace.close(); status.ok()) status = st;
+    if (const auto st = series.close(); status.ok()) status = st;
+    if (series.dropped_rows() > 0) core::log(core::LogLevel::Warn, "series dropped rows=" + std::to_string(series.dropped_rows()));
+    if (trace.dropped_rows() > 0) core::log(core::LogLevel::Warn, "feature trace dropped rows=" + std::to_string(trace.dropped_rows()));
     if (!status.ok()) { core::log(core::LogLevel::Error, status.message); return status.code; }
 
     auto executor = platform::make_executor();
@@ -100,24 +260,48 @@ int main(int argc, char** argv) {
     ss << "score=" << metrics.latest_event.score << " confidence=" << metrics.latest_event.confidence
        << " state=" << state_name(metrics.latest_event.state) << " cal=" << static_cast<int>(metrics.latest_event.calibration)
        << " rel=" << metrics.features.relative_motion << " dop=" << metrics.features.doppler_band_energy << " bb=" << metrics.features.baseband_energy
-       << " trigger_th=" << cmd.config.detection.trigger_threshold
-       << " release_th=" << cmd.config.detection.release_threshold << " triggers=" << metrics.triggered_count;
+       << " trigger_th=" << metrics.trigger_threshold << " release_th=" << metrics.release_threshold
+       << " threshold_updates=" << metrics.threshold_updates << " triggers=" << metrics.triggered_count;
+    if (metrics.realtime_factor > 0.0) ss << " realtime_factor=" << metrics.realtime_factor;
+    if (!cmd.config.audio.record_path.empty()) {
+        ss << " recorded_frames=" << metrics.recorded_frames << " record_dropped_blocks=" << metrics.record_dropped_blocks;
+    }
+    if (metrics.input_channels > 1) ss << " channels=" << metrics.input_channels << " dominant=" << metrics.dominant_channel;
+    const auto& t = metrics.timing;
+    ss << " callback_p50_us=" << t.compute_p50_us << " callback_p99_us=" << t.compute_p99_us << " callback_max_us=" << t.compute_max_us
+       << " deadline_misses=" << t.deadline_misses << " min_headroom_us=" << t.min_headroom_us << " jitter_p99_us=" << t.jitter_p99_us
+       << " stage_us=";
+    // "-" marks a stage the pipeline folds into the next one.
+    for (std::size_t i = 0; i < core::kDspStages; ++i) {
+        ss << (i ? "/" : "");
+        if (std::isnan(t.stage_mean_us[i])) ss << '-';
+        else ss << t.stage_mean_us[i];
+    }
     core::log(core::LogLevel::Info, ss.str());
+    core::flush_log();
 
     if (cmd.kind == app::CommandKind::Calibrate) {
-        std::cout << "recommended_trigger=" << cmd.config.detection.trigger_threshold << " recommended_release=" << cmd.config.detection.release_threshold << '\n';
+        std::cout << "recommended_trigger=" << metrics.trigger_threshold << " recommended_release=" << metrics.release_threshold << '\n';
     }
 
     if (!cmd.csv_path.empty()) {
         std::ofstream csv(cmd.csv_path);
-        csv << "timestamp,state,score,confidence,relative_motion,baseline,doppler,snr\n";
+        csv << "timestamp,state,score,confidence,relative_motion,baseline,doppler,snr,callback_p50_us,callback_p99_us,"
+               "callback_max_us,deadline_misses,min_headroom_us,jitter_p99_us,mix_us,filter_us,features_us,detect_us,journal_us\n";
         csv << metrics.latest_event.timestamp_sec << ',' << state_name(metrics.latest_event.state) << ','
             << metrics.latest_event.score << ',' << metrics.latest_event.confidence << ','
             << metrics.features.relative_motion << ',' << metrics.features.baseline_energy << ','
-            << metrics.features.doppler_band_energy << ',' << metrics.features.snr_estimate << '\n';
+            << metrics.features.doppler_band_energy << ',' << metrics.features.snr_estimate << ','
+            << t.compute_p50_us << ',' << t.compute_p99_us << ',' << t.compute_max_us << ',' << t.deadline_misses << ','
+            << t.min_headroom_us << ',' << t.jitter_p99_us;
+        for (const double us : t.stage_mean_us) {
+            csv << ',';
+            if (!std::isnan(us)) csv << us; // empty: not timed on its own
+        }
+        csv << '\n';
     }
 
     std::ofstream ev("sonarlock_events.json");
-    ev << pipeline.dump_events_json(cmd.dump_count);
+    ev << pipeline->journal()->dump_json_array(cmd.dump_count);
     return 0;
 }
@@ -1,6 +1,7 @@
 #include "sonarlock/audio/audio_factory.hpp"
 
 #include "sonarlock/audio/fake_audio_backend.hpp"
+#include "sonarlock/audio/file_audio_backend.hpp"
 #include "sonarlock/audio/portaudio_backend.hpp"
 
 namespace sonarlock::audio {
@@ -10,6 +11,7 @@ std::unique_ptr<core::IAudioBackend> make_backend(core::BackendKind kind, core::
     if (kind == core::BackendKind::Real) {
         return std::make_unique<PortAudioBackend>();
     }
+    if (kind == core::BackendKind::File) return std::make_unique<FileAudioBackend>();
     return std::make_unique<FakeAudioBackend>(scenario, seed);
 }
 
@@ -1,70 +1,85 @@
 #include "sonarlock/audio/fake_audio_backend.hpp"
 
-#include <cmath>
-#include <random>
+#include "sonarlock/audio/scenario_synth.hpp"
+#include "sonarlock/core/alloc_audit.hpp"
+#include "sonarlock/core/async_dsp_runner.hpp"
+#include "sonarlock/core/capture_recorder.hpp"
 
-namespace sonarlock::audio {
+#include <chrono>
+#include <memory>
 
-namespace {
-constexpr double kTwoPi = 6.28318530717958647692;
-}
+namespace sonarlock::audio {
 
 FakeAudioBackend::FakeAudioBackend(core::FakeScenario scenario, std::uint32_t seed) : scenario_(scenario), seed_(seed) {}
 
 std::vector<core::AudioDeviceInfo> FakeAudioBackend::enumerate_devices() const {
-    return {{0, "Fake Loopback Device", 1, 1, 48000.0}};
+    return {{0, "Fake Loopback Device", static_cast<int>(core::kMaxInputChannels), 1, 48000.0}};
+}
+
+std::pair<double, double> FakeAudioBackend::motion_window(core::FakeScenario scenario, double run_seconds) {
+    if (scenario != core::FakeScenario::Human) return {-1.0, -1.0};
+    return {0.80 * run_seconds, 0.98 * run_seconds};
+}
+
+core::FakeScenario FakeAudioBackend::effective_scenario(core::FakeScenario configured) const {
+    for (const auto s : {core::FakeScenario::Human, core::FakeScenario::Pet, core::FakeScenario::Vibration}) {
+        if (configured == s || scenario_ == s) return s;
+    }
+    return core::FakeScenario::Static;
 }
 
 core::Status FakeAudioBackend::run_session(const core::AudioConfig& config, core::IDspPipeline& pipeline,
                                            core::RuntimeMetrics& out_metrics, const std::function<bool()>& should_stop) {
     const auto& a = config.audio;
-    if (a.sample_rate_hz <= 0.0 || a.frames_per_buffer == 0) {
+    if (a.sample_rate_hz <= 0.0 || a.frames_per_buffer == 0 || a.input_channels == 0 ||
+        a.input_channels > core::kMaxInputChannels) {
         return core::Status::error(core::kErrInvalidArgument, "invalid audio configuration");
     }
 
     pipeline.begin_session(config);
+    core::CaptureTap tap;
+    if (auto st = tap.open(config); !st.ok()) return st;
+    core::alloc_audit::reset();
     const double run_sec = (a.duration_seconds <= 0.0) ? 60.0 : a.duration_seconds;
     const std::size_t total_frames = static_cast<std::size_t>(a.sample_rate_hz * run_sec);
 
-    std::vector<float> input(a.frames_per_buffer, 0.0F);
+    const std::size_t channels = a.input_channels;
+    std::vector<float> input(a.frames_per_buffer * channels, 0.0F);
     std::vector<float> output(a.frames_per_buffer, 0.0F);
 
-    std::mt19937 rng(config.seed == 0 ? seed_ : config.seed);
-    std::uniform_real_distribution<float> noise(-0.01F, 0.01F);
-    std::uniform_real_distribution<float> jitter(-1.0F, 1.0F);
-
+    ScenarioSynth synth(config, effective_scenario(config.scenario), config.seed == 0 ? seed_ : config.seed, run_sec);
+    std::unique_ptr<core::AsyncDspRunner> runner;
+    if (a.decoupled_dsp) {
+        runner = std::make_unique<core::AsyncDspRunner>(pipeline, config);
+        runner->start();
+    }
     std::size_t offset = 0;
-    double phase = 0.0;
+    const auto start = std::chrono::steady_clock::now();
     while (offset < total_frames && !should_stop()) {
         const std::size_t frames = std::min(a.frames_per_buffer, total_frames - offset);
-        input.assign(a.frames_per_buffer, 0.0F);
-        for (std::size_t i = 0; i < frames; ++i) {
-            const double t = static_cast<double>(offset + i) / a.sample_rate_hz;
-            double freq = a.f0_hz;
-            double amp = 0.25;
-            double extra = 0.0;
-            if (config.scenario == core::FakeScenario::Human || scenario_ == core::FakeScenario::Human) {
-                const double gate = (t > 0.80 * run_sec && t < 0.98 * run_sec) ? 1.0 : 0.0;
-                amp = 0.24;
-                extra = gate * 0.45 * std::sin(kTwoPi * (a.f0_hz + 120.0) * t);
-            } else if (config.scenario == core::FakeScenario::Pet || scenario_ == core::FakeScenario::Pet) {
-                amp = 0.08 + 0.02 * std::sin(kTwoPi * 7.0 * t);
-                extra = 0.04 * std::sin(kTwoPi * (a.f0_hz + 25.0 + jitter(rng)) * t);
-            } else if (config.scenario == core::FakeScenario::Vibration || scenario_ == core::FakeScenario::Vibration) {
-                amp = 0.28 * (1.0 + 0.35 * std::sin(kTwoPi * 8.0 * t));
-            }
-            phase += kTwoPi * freq / a.sample_rate_hz;
-            if (phase >= kTwoPi) phase -= kTwoPi;
-            input[i] = static_cast<float>(amp * std::sin(phase) + extra + noise(rng));
-        }
+        synth.render(offset, std::span<float>(input.data(), frames * channels));
+        if (runner) runner->wait_ready(frames);
 
-        pipeline.process(std::span<const float>(input.data(), frames), std::span<float>(output.data(), frames), offset);
+        {
+            const core::alloc_audit::CallbackScope audit;
+            const std::span<const float> in(input.data(), frames * channels);
+            const std::span<float> out(output.data(), frames);
+            if (runner) runner->exchange(in, out);
+            else pipeline.process(in, out, offset);
+            tap.push(in, out);
+        }
         offset += frames;
     }
+    if (runner) runner->stop();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
     out_metrics = pipeline.metrics();
     out_metrics.xruns = 0;
-    return core::Status::success();
+    if (runner) runner->fill_metrics(out_metrics);
+    out_metrics.callback_allocations = core::alloc_audit::callback_allocations();
+    // Includes synthesising the input, so this is a floor for the pipeline alone.
+    out_metrics.realtime_factor = wall > 0.0 ? static_cast<double>(offset) / a.sample_rate_hz / wall : 0.0;
+    return tap.close(out_metrics);
 }
 
 } // namespace sonarlock::audio
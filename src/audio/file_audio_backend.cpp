@@ -0,0 +1,188 @@
+#include "sonarlock/audio/file_audio_backend.hpp"
+
+#include "sonarlock/core/alloc_audit.hpp"
+#include "sonarlock/core/async_dsp_runner.hpp"
+#include "sonarlock/core/mapped_file.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sonarlock::audio {
+
+namespace {
+
+enum class SampleFormat { Pcm16, Pcm24, Float32 };
+
+struct AudioData {
+    SampleFormat format{SampleFormat::Float32};
+    std::size_t channels{1};
+    double sample_rate_hz{0.0};
+    std::span<const std::byte> samples; // interleaved, little-endian
+};
+
+std::uint32_t le32(const std::byte* p) {
+    return std::to_integer<std::uint32_t>(p[0]) | std::to_integer<std::uint32_t>(p[1]) << 8 |
+           std::to_integer<std::uint32_t>(p[2]) << 16 | std::to_integer<std::uint32_t>(p[3]) << 24;
+}
+
+std::uint16_t le16(const std::byte* p) {
+    return static_cast<std::uint16_t>(std::to_integer<unsigned>(p[0]) | std::to_integer<unsigned>(p[1]) << 8);
+}
+
+bool has_tag(std::span<const std::byte> b, std::size_t at, const char* tag) {
+    return b.size() >= at + 4 && std::memcmp(b.data() + at, tag, 4) == 0;
+}
+
+// RIFF/WAVE with a PCM (1), IEEE float (3) or WAVE_FORMAT_EXTENSIBLE fmt chunk.
+core::Status parse_wav(std::span<const std::byte> b, AudioData& out) {
+    constexpr std::uint16_t kPcm = 1;
+    constexpr std::uint16_t kFloat = 3;
+    constexpr std::uint16_t kExtensible = 0xFFFE;
+    bool have_fmt = false;
+    std::uint16_t tag = 0;
+    std::uint16_t bits = 0;
+    std::size_t at = 12;
+    while (at + 8 <= b.size()) {
+        const std::size_t size = le32(b.data() + at + 4);
+        const std::size_t body = at + 8;
+        if (has_tag(b, at, "fmt ") && size >= 16 && body + size <= b.size()) {
+            tag = le16(b.data() + body);
+            out.channels = le16(b.data() + body + 2);
+            out.sample_rate_hz = static_cast<double>(le32(b.data() + body + 4));
+            bits = le16(b.data() + body + 14);
+            if (tag == kExtensible && size >= 26) tag = le16(b.data() + body + 24); // first bytes of the subformat GUID
+            have_fmt = true;
+        } else if (has_tag(b, at, "data")) {
+            if (!have_fmt) break;
+            out.samples = b.subspan(body, std::min(size, b.size() - body)); // tolerate truncated captures
+            if (tag == kPcm && bits == 16) out.format = SampleFormat::Pcm16;
+            else if (tag == kPcm && bits == 24) out.format = SampleFormat::Pcm24;
+            else if (tag == kFloat && bits == 32) out.format = SampleFormat::Float32;
+            else return core::Status::error(core::kErrInputFile, "unsupported WAV sample format");
+            return core::Status::success();
+        }
+        at = body + size + (size & 1U);
+    }
+    return core::Status::error(core::kErrInputFile, "WAV file without fmt/data chunks");
+}
+
+std::size_t bytes_per_sample(SampleFormat f) {
+    switch (f) {
+    case SampleFormat::Pcm16: return 2;
+    case SampleFormat::Pcm24: return 3;
+    case SampleFormat::Float32: return 4;
+    }
+    return 4;
+}
+
+void convert(SampleFormat f, const std::byte* in, std::span<float> out) {
+    switch (f) {
+    case SampleFormat::Pcm16:
+        for (std::size_t k = 0; k < out.size(); ++k) {
+            out[k] = static_cast<float>(static_cast<std::int16_t>(le16(in + 2 * k))) * (1.0F / 32768.0F);
+        }
+        break;
+    case SampleFormat::Pcm24:
+        for (std::size_t k = 0; k < out.size(); ++k) {
+            const std::byte* p = in + 3 * k;
+            const std::uint32_t u = std::to_integer<std::uint32_t>(p[0]) << 8 | std::to_integer<std::uint32_t>(p[1]) << 16 |
+                                    std::to_integer<std::uint32_t>(p[2]) << 24;
+            out[k] = static_cast<float>(static_cast<std::int32_t>(u) >> 8) * (1.0F / 8388608.0F);
+        }
+        break;
+    case SampleFormat::Float32:
+        for (std::size_t k = 0; k < out.size(); ++k) out[k] = std::bit_cast<float>(le32(in + 4 * k));
+        break;
+    }
+}
+
+} // namespace
+
+std::vector<core::AudioDeviceInfo> FileAudioBackend::enumerate_devices() const {
+    return {{0, "File Input (--input)", static_cast<int>(core::kMaxInputChannels), 0, 0.0}};
+}
+
+core::Status FileAudioBackend::run_session(const core::AudioConfig& config, core::IDspPipeline& pipeline,
+                                           core::RuntimeMetrics& out_metrics, const std::function<bool()>& should_stop) {
+    if (config.audio.input_path.empty()) return core::Status::error(core::kErrInvalidArgument, "file backend needs --input");
+    if (config.audio.frames_per_buffer == 0) return core::Status::error(core::kErrInvalidArgument, "invalid audio configuration");
+
+    core::MappedFile file;
+    if (auto st = file.open(config.audio.input_path); !st.ok()) return st;
+    const auto bytes = file.bytes();
+
+    AudioData data;
+    if (has_tag(bytes, 0, "RIFF") && has_tag(bytes, 8, "WAVE")) {
+        if (auto st = parse_wav(bytes, data); !st.ok()) return st;
+    } else {
+        data.channels = config.audio.input_channels;
+        data.sample_rate_hz = config.audio.sample_rate_hz;
+        data.samples = bytes;
+    }
+    if (data.channels == 0 || data.channels > core::kMaxInputChannels || data.sample_rate_hz <= 0.0) {
+        return core::Status::error(core::kErrInputFile, "unsupported channel count or sample rate in input");
+    }
+
+    const std::size_t channels = data.channels;
+    const std::size_t frame_bytes = channels * bytes_per_sample(data.format);
+    const std::size_t total_frames = data.samples.size() / frame_bytes;
+
+    core::AudioConfig session = config;
+    session.audio.sample_rate_hz = data.sample_rate_hz;
+    session.audio.input_channels = channels;
+    session.audio.duration_seconds = static_cast<double>(total_frames) / data.sample_rate_hz;
+
+    // Little-endian float32 at float alignment is passed straight from the mapping.
+    const bool zero_copy = data.format == SampleFormat::Float32 && std::endian::native == std::endian::little &&
+                           reinterpret_cast<std::uintptr_t>(data.samples.data()) % alignof(float) == 0;
+    const std::size_t block = session.audio.frames_per_buffer;
+    std::vector<float> input(zero_copy ? 0 : block * channels, 0.0F);
+    std::vector<float> output(block, 0.0F);
+
+    pipeline.begin_session(session);
+    std::unique_ptr<core::AsyncDspRunner> runner;
+    if (session.audio.decoupled_dsp) {
+        runner = std::make_unique<core::AsyncDspRunner>(pipeline, session);
+        runner->start();
+    }
+    core::alloc_audit::reset();
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t offset = 0;
+    while (offset < total_frames && !should_stop()) {
+        const std::size_t frames = std::min(block, total_frames - offset);
+        const std::byte* src = data.samples.data() + offset * frame_bytes;
+        std::span<const float> in;
+        if (zero_copy) {
+            in = std::span<const float>(reinterpret_cast<const float*>(src), frames * channels);
+        } else {
+            convert(data.format, src, std::span<float>(input.data(), frames * channels));
+            in = std::span<const float>(input.data(), frames * channels);
+        }
+        if (runner) runner->wait_ready(frames);
+        {
+            const core::alloc_audit::CallbackScope audit;
+            const std::span<float> out(output.data(), frames);
+            if (runner) runner->exchange(in, out);
+            else pipeline.process(in, out, offset);
+        }
+        offset += frames;
+    }
+    if (runner) runner->stop();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    out_metrics = pipeline.metrics();
+    out_metrics.xruns = 0;
+    if (runner) runner->fill_metrics(out_metrics);
+    out_metrics.callback_allocations = core::alloc_audit::callback_allocations();
+    out_metrics.realtime_factor = wall > 0.0 ? static_cast<double>(offset) / data.sample_rate_hz / wall : 0.0;
+    return core::Status::success();
+}
+
+} // namespace sonarlock::audio
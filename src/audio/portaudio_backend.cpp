@@ -1,10 +1,16 @@
 #include "sonarlock/audio/portaudio_backend.hpp"
 
+#include "sonarlock/core/alloc_audit.hpp"
+#include "sonarlock/core/async_dsp_runner.hpp"
+#include "sonarlock/core/capture_recorder.hpp"
+
 #if defined(SONARLOCK_HAS_PORTAUDIO)
 #include <portaudio.h>
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 namespace sonarlock::audio {
@@ -29,15 +35,39 @@ std::vector<core::AudioDeviceInfo> PortAudioBackend::enumerate_devices() const {
 core::Status PortAudioBackend::run_session(const core::AudioConfig& config, core::IDspPipeline& pipeline,
                                            core::RuntimeMetrics& out_metrics, const std::function<bool()>& should_stop) {
 #if defined(SONARLOCK_HAS_PORTAUDIO)
+    if (config.audio.input_channels == 0 || config.audio.input_channels > core::kMaxInputChannels) {
+        return core::Status::error(core::kErrInvalidArgument, "invalid input channel count");
+    }
     if (Pa_Initialize() != paNoError) return core::Status::error(core::kErrBackendUnavailable, "failed to initialize PortAudio");
 
+    // Everything the callback touches is allocated here, before the stream starts.
     struct Ctx {
         core::IDspPipeline* pipeline;
+        core::AsyncDspRunner* runner; // decoupled mode only
+        core::CaptureTap* tap;
         std::size_t frame_offset;
         std::size_t total_frames;
-    } ctx{&pipeline, 0, static_cast<std::size_t>(config.audio.sample_rate_hz * ((config.audio.duration_seconds<=0)?60.0:config.audio.duration_seconds))};
+        std::vector<float> silent_input;
+        std::vector<float> discarded_output;
+        std::size_t channels; // interleaved capture channels
+        std::atomic<std::uint64_t> xruns{0};
+    } ctx{&pipeline, nullptr, nullptr, 0, static_cast<std::size_t>(config.audio.sample_rate_hz * ((config.audio.duration_seconds<=0)?60.0:config.audio.duration_seconds)),
+          std::vector<float>(config.audio.frames_per_buffer * config.audio.input_channels, 0.0F),
+          std::vector<float>(config.audio.frames_per_buffer, 0.0F), config.audio.input_channels};
 
     pipeline.begin_session(config);
+    core::CaptureTap tap;
+    if (auto st = tap.open(config); !st.ok()) {
+        Pa_Terminate();
+        return st;
+    }
+    ctx.tap = &tap;
+    std::unique_ptr<core::AsyncDspRunner> runner;
+    if (config.audio.decoupled_dsp) {
+        runner = std::make_unique<core::AsyncDspRunner>(pipeline, config);
+        ctx.runner = runner.get();
+    }
+    core::alloc_audit::reset();
 
     PaStreamParameters in_params{}, out_params{};
     in_params.device = Pa_GetDefaultInputDevice();
@@ -46,26 +76,35 @@ core::Status PortAudioBackend::run_session(const core::AudioConfig& config, core
         Pa_Terminate();
         return core::Status::error(core::kErrAudioDeviceUnavailable, "missing default input/output device");
     }
-    in_params.channelCount = 1; out_params.channelCount = 1;
+    if (Pa_GetDeviceInfo(in_params.device)->maxInputChannels < static_cast<int>(config.audio.input_channels)) {
+        Pa_Terminate();
+        return core::Status::error(core::kErrAudioDeviceUnavailable, "default input device has too few channels");
+    }
+    in_params.channelCount = static_cast<int>(config.audio.input_channels); out_params.channelCount = 1;
     in_params.sampleFormat = paFloat32; out_params.sampleFormat = paFloat32;
     in_params.suggestedLatency = Pa_GetDeviceInfo(in_params.device)->defaultLowInputLatency;
     out_params.suggestedLatency = Pa_GetDeviceInfo(out_params.device)->defaultLowOutputLatency;
 
     PaStream* stream = nullptr;
     const auto cb = [](const void* input_buffer, void* output_buffer, unsigned long frames_per_buffer,
-                       const PaStreamCallbackTimeInfo*, PaStreamCallbackFlags, void* user_data) {
+                       const PaStreamCallbackTimeInfo*, PaStreamCallbackFlags status, void* user_data) -> int {
+        const core::alloc_audit::CallbackScope audit;
         auto* ctx = static_cast<Ctx*>(user_data);
+        if (status & (paInputOverflow | paInputUnderflow | paOutputOverflow | paOutputUnderflow)) {
+            ctx->xruns.fetch_add(1, std::memory_order_relaxed);
+        }
         auto* input = static_cast<const float*>(input_buffer);
         auto* output = static_cast<float*>(output_buffer);
         const std::size_t rem = ctx->total_frames > ctx->frame_offset ? (ctx->total_frames - ctx->frame_offset) : 0;
-        const std::size_t frames = std::min<std::size_t>(frames_per_buffer, rem);
-        std::vector<float> in(frames, 0.0F), out(frames, 0.0F);
-        if (input) std::copy(input, input + frames, in.begin());
-        ctx->pipeline->process(in, out, ctx->frame_offset);
-        if (output) {
-            std::fill(output, output + frames_per_buffer, 0.0F);
-            std::copy(out.begin(), out.end(), output);
-        }
+        std::size_t frames = std::min<std::size_t>(frames_per_buffer, rem);
+        if (!input || !output) frames = std::min(frames, ctx->discarded_output.size());
+        // The pipeline reads the device buffer in place and renders TX straight into it.
+        const std::span<const float> in(input ? input : ctx->silent_input.data(), frames * ctx->channels);
+        const std::span<float> out(output ? output : ctx->discarded_output.data(), frames);
+        if (ctx->runner) ctx->runner->exchange(in, out);
+        else ctx->pipeline->process(in, out, ctx->frame_offset);
+        ctx->tap->push(in, out);
+        if (output) std::fill(output + frames, output + frames_per_buffer, 0.0F);
         ctx->frame_offset += frames;
         return (ctx->frame_offset >= ctx->total_frames) ? paComplete : paContinue;
     };
@@ -75,6 +114,7 @@ core::Status PortAudioBackend::run_session(const core::AudioConfig& config, core
         Pa_Terminate();
         return core::Status::error(core::kErrStreamFailure, "failed to open PortAudio stream");
     }
+    if (runner) runner->start();
     if (Pa_StartStream(stream) != paNoError) {
         Pa_CloseStream(stream);
         Pa_Terminate();
@@ -85,8 +125,12 @@ core::Status PortAudioBackend::run_session(const core::AudioConfig& config, core
         Pa_Sleep(10);
     }
     Pa_StopStream(stream); Pa_CloseStream(stream); Pa_Terminate();
+    if (runner) runner->stop();
     out_metrics = pipeline.metrics();
-    return core::Status::success();
+    out_metrics.xruns = ctx.xruns.load();
+    if (runner) runner->fill_metrics(out_metrics);
+    out_metrics.callback_allocations = core::alloc_audit::callback_allocations();
+    return tap.close(out_metrics);
 #else
     (void)config; (void)pipeline; (void)out_metrics; (void)should_stop;
     return core::Status::error(core::kErrBackendUnavailable, "PortAudio backend unavailable: dependency not found");
@@ -0,0 +1,133 @@
+#include "sonarlock/audio/scenario_synth.hpp"
+
+#include "sonarlock/audio/fake_audio_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sonarlock::audio {
+
+namespace {
+constexpr double kTwoPi = 6.28318530717958647692;
+constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+std::uint64_t mix64(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Element `counter` of the SplitMix64 sequence starting at key, without visiting the ones before.
+std::uint64_t splitmix_at(std::uint64_t key, std::uint64_t counter) { return mix64(key + (counter + 1) * kGolden); }
+
+// Top 24 bits as [-1, 1).
+double to_signed_unit(std::uint64_t bits) { return static_cast<double>(bits >> 40) * (1.0 / 8388608.0) - 1.0; }
+
+// Smallest frame whose time n / rate is past `sec` (or at it, when inclusive), as the old per-sample test had it.
+std::size_t first_frame_after(double sec, double rate, bool inclusive) {
+    const auto passed = [&](std::size_t n) {
+        const double t = static_cast<double>(n) / rate;
+        return inclusive ? t >= sec : t > sec;
+    };
+    auto n = static_cast<std::size_t>(std::max(0.0, std::floor(sec * rate)));
+    while (!passed(n)) ++n;
+    while (n > 0 && passed(n - 1)) --n;
+    return n;
+}
+
+// sin(2 pi k / 256): the Pet clutter is a sine at a random phase per sample.
+const std::array<double, 256>& clutter_table() {
+    static const std::array<double, 256> table = [] {
+        std::array<double, 256> t{};
+        for (std::size_t k = 0; k < t.size(); ++k) t[k] = std::sin(kTwoPi * static_cast<double>(k) / 256.0);
+        return t;
+    }();
+    return table;
+}
+} // namespace
+
+void ScenarioSynth::Phasor::seek(std::size_t frame) {
+    const double cycles = cycles_per_frame * static_cast<double>(frame);
+    const double phase = kTwoPi * (cycles - std::floor(cycles));
+    re = std::cos(phase);
+    im = std::sin(phase);
+}
+
+ScenarioSynth::ScenarioSynth(const core::AudioConfig& config, core::FakeScenario scenario, std::uint32_t seed, double run_seconds)
+    : scenario_(scenario), channels_(std::clamp<std::size_t>(config.audio.input_channels, 1, core::kMaxInputChannels)) {
+    const double rate = config.audio.sample_rate_hz;
+    const auto init = [rate](Phasor& p, double hz) {
+        p.cycles_per_frame = hz / rate;
+        p.step_re = std::cos(kTwoPi * p.cycles_per_frame);
+        p.step_im = std::sin(kTwoPi * p.cycles_per_frame);
+    };
+    init(carrier_, config.audio.f0_hz);
+    init(echo_, config.audio.f0_hz + 120.0);
+    init(wobble_, scenario == core::FakeScenario::Pet ? 7.0 : 8.0);
+
+    const std::uint64_t key = mix64(seed + kGolden);
+    for (std::size_t c = 0; c < channels_; ++c) {
+        noise_keys_[c] = splitmix_at(key, c);
+        gain_[c] = 1.0 / (1.0 + 0.25 * static_cast<double>(c));
+        shift_cos_[c] = std::cos(0.9 * static_cast<double>(c));
+        shift_sin_[c] = std::sin(0.9 * static_cast<double>(c));
+    }
+    clutter_key_ = splitmix_at(key, core::kMaxInputChannels);
+
+    if (scenario == core::FakeScenario::Human) {
+        const auto [start, end] = FakeAudioBackend::motion_window(scenario, run_seconds);
+        gate_begin_ = first_frame_after(start, rate, false);
+        gate_end_ = first_frame_after(end, rate, true);
+    }
+}
+
+void ScenarioSynth::seek(std::size_t frame) {
+    // Step from the segment start exactly as a sequential render would.
+    const std::size_t base = frame - frame % kSegmentFrames;
+    for (Phasor* p : {&carrier_, &echo_, &wobble_}) {
+        p->seek(base);
+        for (std::size_t n = base; n < frame; ++n) p->advance();
+    }
+}
+
+void ScenarioSynth::render(std::size_t first_frame, std::span<float> out) {
+    const std::size_t frames = out.size() / channels_;
+    if (first_frame != next_frame_) seek(first_frame);
+    const auto& clutter = clutter_table();
+    float* dst = out.data();
+    for (std::size_t n = first_frame; n < first_frame + frames; ++n) {
+        if (n % kSegmentFrames == 0) {
+            carrier_.seek(n);
+            echo_.seek(n);
+            wobble_.seek(n);
+        }
+        double amp = 0.25;
+        double extra = 0.0;
+        switch (scenario_) {
+        case core::FakeScenario::Human:
+            amp = 0.24;
+            if (n >= gate_begin_ && n < gate_end_) extra = 0.45 * echo_.im;
+            break;
+        case core::FakeScenario::Pet:
+            amp = 0.08 + 0.02 * wobble_.im;
+            extra = 0.04 * clutter[splitmix_at(clutter_key_, n) >> 56];
+            break;
+        case core::FakeScenario::Vibration:
+            amp = 0.28 * (1.0 + 0.35 * wobble_.im);
+            break;
+        case core::FakeScenario::Static:
+            break;
+        }
+        for (std::size_t c = 0; c < channels_; ++c) {
+            const double tone = amp * (carrier_.im * shift_cos_[c] - carrier_.re * shift_sin_[c]);
+            const double noise = 0.01 * to_signed_unit(splitmix_at(noise_keys_[c], n));
+            *dst++ = static_cast<float>(gain_[c] * (tone + extra) + noise);
+        }
+        carrier_.advance();
+        echo_.advance();
+        wobble_.advance();
+    }
+    next_frame_ = first_frame + frames;
+}
+
+} // namespace sonarlock::audio
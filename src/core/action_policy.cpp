@@ -1,5 +1,7 @@
 #include "sonarlock/core/action_policy.hpp"
 
+#include <algorithm>
+
 namespace sonarlock::core {
 
 ActionRequest DefaultActionPolicy::map(const MotionEvent& event, ActionMode mode) {
@@ -9,18 +11,23 @@ ActionRequest DefaultActionPolicy::map(const MotionEvent& event, ActionMode mode
     return {ActionType::Beep, event.timestamp_sec, "triggered_motion"};
 }
 
-ActionSafetyController::ActionSafetyController(DetectionSection config) : cfg_(config) {}
+ActionSafetyController::ActionSafetyController(DetectionSection config)
+    : cfg_(config), lock_times_(std::max<std::uint32_t>(config.max_locks_per_minute, 1)) {}
 
 bool ActionSafetyController::allow(const ActionRequest& req, bool manual_disable, double now_sec) {
     if (manual_disable || req.type == ActionType::None) return false;
     if (now_sec * 1000.0 < static_cast<double>(cfg_.arming_delay_ms)) return false;
 
-    while (!lock_times_.empty() && now_sec - lock_times_.front() > 60.0) lock_times_.pop_front();
+    while (lock_count_ > 0 && now_sec - lock_times_[lock_head_] > 60.0) {
+        lock_head_ = (lock_head_ + 1) % lock_times_.size();
+        --lock_count_;
+    }
 
     if (req.type == ActionType::LockScreen) {
         if (now_sec < lock_cooldown_until_) return false;
-        if (lock_times_.size() >= cfg_.max_locks_per_minute) return false;
-        lock_times_.push_back(now_sec);
+        if (lock_count_ >= cfg_.max_locks_per_minute) return false;
+        lock_times_[(lock_head_ + lock_count_) % lock_times_.size()] = now_sec;
+        ++lock_count_;
         lock_cooldown_until_ = now_sec + static_cast<double>(cfg_.lock_cooldown_ms) / 1000.0;
     }
     return true;
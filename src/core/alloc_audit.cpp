@@ -0,0 +1,116 @@
+#include "sonarlock/core/alloc_audit.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace sonarlock::core::alloc_audit {
+
+namespace {
+std::atomic<std::uint64_t> g_callback_allocations{0};
+thread_local int t_callback_depth = 0;
+} // namespace
+
+#if defined(SONARLOCK_AUDIT_ALLOCATIONS)
+
+namespace detail {
+void note_allocation() {
+    if (t_callback_depth > 0) g_callback_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+bool enabled() { return true; }
+#else
+bool enabled() { return false; }
+#endif
+
+std::uint64_t callback_allocations() { return g_callback_allocations.load(std::memory_order_relaxed); }
+
+void reset() { g_callback_allocations.store(0, std::memory_order_relaxed); }
+
+CallbackScope::CallbackScope() { ++t_callback_depth; }
+
+CallbackScope::~CallbackScope() { --t_callback_depth; }
+
+} // namespace sonarlock::core::alloc_audit
+
+#if defined(SONARLOCK_AUDIT_ALLOCATIONS)
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+}
+#endif
+
+namespace {
+void* counted_alloc(std::size_t n) {
+    sonarlock::core::alloc_audit::detail::note_allocation();
+#if defined(__GLIBC__)
+    if (void* p = __libc_malloc(n == 0 ? 1 : n)) return p;
+#else
+    if (void* p = std::malloc(n == 0 ? 1 : n)) return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void* counted_aligned_alloc(std::size_t n, std::align_val_t al) {
+    sonarlock::core::alloc_audit::detail::note_allocation();
+    const auto a = static_cast<std::size_t>(al);
+#if defined(_WIN32)
+    if (void* p = _aligned_malloc(n == 0 ? 1 : n, a)) return p;
+#else
+    if (void* p = std::aligned_alloc(a, ((n == 0 ? 1 : n) + a - 1) / a * a)) return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void aligned_release(void* p) noexcept {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+} // namespace
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(n); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(n); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t n, std::align_val_t al) { return counted_aligned_alloc(n, al); }
+void* operator new[](std::size_t n, std::align_val_t al) { return counted_aligned_alloc(n, al); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { aligned_release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { aligned_release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { aligned_release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { aligned_release(p); }
+
+#if defined(__GLIBC__)
+// Plain C allocations from the callback (e.g. inside third-party code) go through these.
+extern "C" {
+void* malloc(std::size_t n) {
+    sonarlock::core::alloc_audit::detail::note_allocation();
+    return __libc_malloc(n);
+}
+void* calloc(std::size_t count, std::size_t n) {
+    sonarlock::core::alloc_audit::detail::note_allocation();
+    return __libc_calloc(count, n);
+}
+void* realloc(void* p, std::size_t n) {
+    sonarlock::core::alloc_audit::detail::note_allocation();
+    return __libc_realloc(p, n);
+}
+}
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include "sonarlock/core/async_dsp_runner.hpp"
+
+#include <algorithm>
+
+namespace sonarlock::core {
+
+AsyncDspRunner::AsyncDspRunner(IDspPipeline& pipeline, const AudioConfig& config)
+    : pipeline_(pipeline), block_frames_(std::max<std::size_t>(config.audio.frames_per_buffer, 1)),
+      channels_(std::max<std::size_t>(config.audio.input_channels, 1)),
+      // Poll at a quarter of the buffer period so the worker reacts well within one deadline.
+      idle_wait_(std::max<std::int64_t>(
+          1, static_cast<std::int64_t>(2.5e5 * static_cast<double>(block_frames_) / config.audio.sample_rate_hz))),
+      rx_(block_frames_ * channels_ * std::max<std::size_t>(config.audio.ring_blocks, kTxPrefillBlocks + 1)),
+      tx_(block_frames_ * std::max<std::size_t>(config.audio.ring_blocks, kTxPrefillBlocks + 1)),
+      drops_(std::max<std::size_t>(config.audio.ring_blocks, kTxPrefillBlocks + 1)),
+      work_in_(block_frames_ * channels_, 0.0F), work_out_(block_frames_, 0.0F) {}
+
+AsyncDspRunner::~AsyncDspRunner() { stop(); }
+
+void AsyncDspRunner::start() {
+    if (running_.exchange(true)) return;
+    std::fill(work_out_.begin(), work_out_.end(), 0.0F);
+    for (std::size_t b = 0; b < kTxPrefillBlocks; ++b) tx_.push(work_out_);
+    worker_ = std::thread([this] { worker_loop(); });
+}
+
+void AsyncDspRunner::stop() {
+    running_.store(false);
+    if (worker_.joinable()) worker_.join();
+}
+
+void AsyncDspRunner::exchange(std::span<const float> input, std::span<float> output) {
+    if (rx_.push(input)) {
+        rx_frames_ += input.size() / channels_;
+        const std::size_t fill = rx_.size();
+        if (fill > rx_high_water_.load(std::memory_order_relaxed)) rx_high_water_.store(fill, std::memory_order_relaxed);
+    } else {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        // With drops_ full, a held mark keeps its earlier position and absorbs later drops.
+        if (held_.frames == 0) held_.at = rx_frames_;
+        held_.frames += input.size() / channels_;
+    }
+    if (held_.frames > 0 && drops_.push(std::span<const DropMark>(&held_, 1))) held_ = {};
+    if (!tx_.pop(output)) {
+        underruns_.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t got = tx_.pop_some(output);
+        std::fill(output.begin() + static_cast<std::ptrdiff_t>(got), output.end(), 0.0F);
+    }
+}
+
+void AsyncDspRunner::wait_ready(std::size_t frames) const {
+    while (running_.load(std::memory_order_acquire) &&
+           (rx_.capacity() - rx_.size() < frames * channels_ || tx_.size() < frames)) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncDspRunner::worker_loop() {
+    for (;;) {
+        if (rx_.pop(work_in_)) {
+            apply_drops(read_frames_);
+            read_frames_ += block_frames_;
+            pipeline_.process(work_in_, work_out_, frame_offset_);
+            frame_offset_ += block_frames_;
+            while (!tx_.push(work_out_)) {
+                if (!running_.load(std::memory_order_acquire)) break;
+                std::this_thread::sleep_for(idle_wait_);
+            }
+            tx_high_water_.store(std::max(tx_high_water_.load(std::memory_order_relaxed), tx_.size()),
+                                 std::memory_order_relaxed);
+        } else if (!running_.load(std::memory_order_acquire)) {
+            break;
+        } else {
+            std::this_thread::sleep_for(idle_wait_);
+        }
+    }
+    // Trailing partial block (e.g. the last callback of a fixed-duration session).
+    const std::size_t rest = rx_.pop_some(work_in_) / channels_;
+    if (rest > 0) {
+        apply_drops(read_frames_);
+        read_frames_ += rest;
+        pipeline_.process(std::span<const float>(work_in_.data(), rest * channels_), std::span<float>(work_out_.data(), rest),
+                          frame_offset_);
+        frame_offset_ += rest;
+    }
+}
+
+void AsyncDspRunner::apply_drops(std::size_t position) {
+    for (;;) {
+        if (next_drop_.frames == 0 && !drops_.pop(std::span<DropMark>(&next_drop_, 1))) return;
+        if (next_drop_.at > position) return; // lands inside or after this block: a later block's offset
+        frame_offset_ += next_drop_.frames;
+        next_drop_ = {};
+    }
+}
+
+void AsyncDspRunner::fill_metrics(RuntimeMetrics& metrics) const {
+    metrics.ring_overruns = overruns_.load();
+    metrics.ring_underruns = underruns_.load();
+    metrics.rx_ring_high_water = rx_high_water_.load() / channels_; // ring counts samples
+    metrics.tx_ring_high_water = tx_high_water_.load();
+}
+
+} // namespace sonarlock::core
@@ -0,0 +1,89 @@
+#include "sonarlock/core/batch_engine.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace sonarlock::core {
+
+BatchEngine::BatchEngine(BackendFactory backends, std::size_t workers, PipelineFactory pipelines)
+    : backends_(std::move(backends)), pipelines_(std::move(pipelines)) {
+    if (workers == 0) workers = std::max(1U, std::thread::hardware_concurrency());
+    if (!pipelines_) pipelines_ = [] { return std::make_unique<BasicDspPipeline>(); };
+    for (std::size_t w = 0; w < workers; ++w) queues_.push_back(std::make_unique<WorkQueue>());
+    worker_pipelines_.resize(workers);
+}
+
+BatchEngine::~BatchEngine() = default;
+
+std::vector<BatchResult> BatchEngine::run(std::span<const AudioConfig> jobs) {
+    std::vector<BatchResult> results(jobs.size());
+    steals_.store(0, std::memory_order_relaxed);
+
+    const std::size_t n = workers();
+    for (std::size_t w = 0; w < n; ++w) {
+        const std::size_t begin = jobs.size() * w / n;
+        const std::size_t end = jobs.size() * (w + 1) / n;
+        auto& q = queues_[w]->jobs;
+        q.clear();
+        for (std::size_t j = begin; j < end; ++j) q.push_back(j);
+    }
+
+    // With fewer jobs than workers the surplus queues are stolen from, so no thread is needed for them.
+    const std::size_t active = std::min(n, std::max<std::size_t>(jobs.size(), 1));
+    std::vector<std::thread> threads;
+    threads.reserve(active);
+    for (std::size_t w = 0; w < active; ++w) {
+        threads.emplace_back([this, w, jobs, &results] { worker_loop(w, jobs, results); });
+    }
+    for (auto& t : threads) t.join();
+    cancelled_.store(false, std::memory_order_relaxed);
+    return results;
+}
+
+bool BatchEngine::next_job(std::size_t worker, std::size_t& job) {
+    {
+        auto& own = *queues_[worker];
+        const std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+    // Steal the job its owner would reach last.
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+        auto& victim = *queues_[(worker + k) % queues_.size()];
+        const std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void BatchEngine::worker_loop(std::size_t worker, std::span<const AudioConfig> jobs, std::vector<BatchResult>& results) {
+    auto& pipeline = worker_pipelines_[worker];
+    if (!pipeline) pipeline = pipelines_();
+    const auto should_stop = [this] { return cancelled_.load(std::memory_order_relaxed); };
+
+    std::size_t j = 0;
+    while (next_job(worker, j)) {
+        auto& r = results[j];
+        if (should_stop()) {
+            r.status = Status::error(kErrCancelled, "batch cancelled before the job started");
+            continue;
+        }
+        auto backend = backends_(jobs[j]);
+        if (!backend) {
+            r.status = Status::error(kErrBackendUnavailable, "no backend for batch job");
+            continue;
+        }
+        r.status = backend->run_session(jobs[j], *pipeline, r.metrics, should_stop);
+        if (const auto* journal = pipeline->journal()) journal->copy_to(r.journal);
+    }
+}
+
+} // namespace sonarlock::core
@@ -5,23 +5,87 @@
 
 namespace sonarlock::core {
 
+namespace {
+const double kLogSpan = std::log(StreamingMedianMad::kMaxValue / StreamingMedianMad::kMinValue);
+const double kBinStep = kLogSpan / static_cast<double>(StreamingMedianMad::kBins);
+
+double bin_center(std::size_t idx) {
+    if (idx == 0) return 0.0;
+    return StreamingMedianMad::kMinValue * std::exp((static_cast<double>(idx) - 0.5) * kBinStep);
+}
+} // namespace
+
+double StreamingMedianMad::relative_error() { return std::exp(0.5 * kBinStep) - 1.0; }
+
+void StreamingMedianMad::reset() {
+    bins_.fill(0.0);
+    weight_ = 0.0;
+    count_ = 0;
+}
+
+void StreamingMedianMad::add(double x) {
+    std::size_t idx = 0;
+    if (x >= kMinValue) {
+        const double pos = std::log(x / kMinValue) / kBinStep;
+        idx = std::min(kBins, static_cast<std::size_t>(pos) + 1);
+    }
+    bins_[idx] += 1.0;
+    weight_ += 1.0;
+    ++count_;
+}
+
+void StreamingMedianMad::decay(double factor) {
+    for (auto& b : bins_) b *= factor;
+    weight_ *= factor;
+}
+
+std::pair<double, double> StreamingMedianMad::median_mad() const {
+    if (count_ == 0) return {0.0, 0.0};
+    // Undecayed this picks element count/2, the same one the sorted-vector version picked.
+    const double rank = weight_ * 0.5;
+
+    std::size_t mb = 0;
+    for (double seen = 0.0; mb < kBins; ++mb) {
+        seen += bins_[mb];
+        if (seen > rank) break;
+    }
+    const double median = bin_center(mb);
+
+    // Deviations grow monotonically away from the median bin, so merge outward from both sides.
+    double seen = bins_[mb];
+    std::size_t left = mb;
+    std::size_t right = mb + 1;
+    double mad = 0.0;
+    while (seen <= rank && (left > 0 || right <= kBins)) {
+        const double dl = left > 0 ? median - bin_center(left - 1) : -1.0;
+        const double dr = right <= kBins ? bin_center(right) - median : -1.0;
+        if (dr < 0.0 || (dl >= 0.0 && dl <= dr)) {
+            --left;
+            seen += bins_[left];
+            mad = dl;
+        } else {
+            seen += bins_[right];
+            ++right;
+            mad = dr;
+        }
+    }
+    return {median, mad};
+}
+
 AutoTuner::AutoTuner(CalibrationSection config) : config_(config) {}
 
-void AutoTuner::reset() { samples_.clear(); }
+void AutoTuner::reset() { stats_.reset(); }
+
+void AutoTuner::add_sample(double relative_motion) { stats_.add(relative_motion); }
 
-void AutoTuner::add_sample(double relative_motion) { samples_.push_back(relative_motion); }
+void AutoTuner::decay(double factor) { stats_.decay(factor); }
 
-bool AutoTuner::ready(std::size_t min_samples) const { return samples_.size() >= min_samples; }
+bool AutoTuner::ready(std::size_t min_samples) const { return stats_.count() >= min_samples; }
 
 void AutoTuner::apply(DetectionSection& detection) const {
-    if (samples_.empty()) return;
-    auto s = samples_;
-    std::sort(s.begin(), s.end());
-    const double median = s[s.size() / 2];
-    std::vector<double> dev(s.size());
-    for (std::size_t i = 0; i < s.size(); ++i) dev[i] = std::abs(s[i] - median);
-    std::sort(dev.begin(), dev.end());
-    const double mad = dev[dev.size() / 2] + 1e-6;
+    if (stats_.count() == 0) return;
+    const auto [median, raw_mad] = stats_.median_mad();
+    const double mad = raw_mad + 1e-6;
 
     const double trig = std::clamp(median + config_.trigger_k * mad, config_.min_threshold, config_.max_threshold);
     const double rel = std::clamp(median + config_.release_k * mad, config_.min_threshold * 0.5, trig * 0.95);
@@ -30,16 +94,20 @@ void AutoTuner::apply(DetectionSection& detection) const {
 }
 
 CalibrationController::CalibrationController(CalibrationSection cal, DetectionSection det)
-    : cal_(cal), default_det_(det), tuner_(cal) {}
+    : cal_(cal), default_det_(det), tuned_det_(det), tuner_(cal) {}
 
 void CalibrationController::reset() {
     state_ = CalibrationState::Init;
     tuner_.reset();
+    tuned_det_ = default_det_;
+    last_adapt_sec_ = 0.0;
+    threshold_updates_ = 0;
 }
 
 CalibrationState CalibrationController::state() const { return state_; }
 
-void CalibrationController::update(double timestamp_sec, double relative_motion, DetectionSection& det_inout) {
+void CalibrationController::update(double timestamp_sec, double relative_motion, DetectionSection& det_inout,
+                                   DetectionState detector_state) {
     if (!cal_.enabled) {
         state_ = CalibrationState::Armed;
         return;
@@ -54,11 +122,39 @@ void CalibrationController::update(double timestamp_sec, double relative_motion,
     if (state_ == CalibrationState::Calibrating) {
         tuner_.add_sample(relative_motion);
         if (timestamp_sec >= cal_.warmup_seconds + cal_.calibrate_seconds && tuner_.ready(64)) {
-            det_inout = default_det_;
-            tuner_.apply(det_inout);
+            tuned_det_ = default_det_;
+            tuner_.apply(tuned_det_);
             state_ = CalibrationState::Armed;
+            last_adapt_sec_ = timestamp_sec;
+            det_inout = tuned_det_;
         }
+    } else if (state_ == CalibrationState::Armed && cal_.adapt && detector_state == DetectionState::Idle) {
+        tuner_.add_sample(relative_motion);
+        if (timestamp_sec - last_adapt_sec_ >= cal_.adapt_interval_seconds) adapt(timestamp_sec);
+    }
+    // Without adaptation the tuned values only reach the detector on the Armed transition.
+    if (cal_.adapt && state_ == CalibrationState::Armed) det_inout = tuned_det_;
+}
+
+void CalibrationController::adapt(double timestamp_sec) {
+    const double elapsed = timestamp_sec - last_adapt_sec_;
+    last_adapt_sec_ = timestamp_sec;
+
+    DetectionSection target = tuned_det_;
+    tuner_.apply(target);
+    const double step = cal_.adapt_max_step;
+    const double trig = std::clamp(target.trigger_threshold, tuned_det_.trigger_threshold - step,
+                                   tuned_det_.trigger_threshold + step);
+    double rel = std::clamp(target.release_threshold, tuned_det_.release_threshold - step,
+                            tuned_det_.release_threshold + step);
+    rel = std::min(rel, trig * 0.95);
+    if (trig != tuned_det_.trigger_threshold || rel != tuned_det_.release_threshold) {
+        tuned_det_.trigger_threshold = trig;
+        tuned_det_.release_threshold = rel;
+        ++threshold_updates_;
     }
+
+    if (cal_.adapt_window_seconds > 0.0) tuner_.decay(std::exp(-elapsed / cal_.adapt_window_seconds));
 }
 
 } // namespace sonarlock::core
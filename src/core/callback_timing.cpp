@@ -0,0 +1,89 @@
+#include "sonarlock/core/callback_timing.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace sonarlock::core {
+
+std::size_t LatencyHistogram::bucket(std::uint64_t ns) {
+    if (ns < kSub) return static_cast<std::size_t>(ns);
+    const unsigned shift = static_cast<unsigned>(std::bit_width(ns)) - 1 - kSubBits;
+    return (shift + 1) * kSub + static_cast<std::size_t>((ns >> shift) & (kSub - 1));
+}
+
+std::uint64_t LatencyHistogram::bucket_upper(std::size_t index) {
+    if (index < kSub) return index;
+    const unsigned shift = static_cast<unsigned>(index / kSub) - 1;
+    const std::uint64_t lower = static_cast<std::uint64_t>(kSub + index % kSub) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean_ns() const {
+    const auto n = count();
+    return n > 0 ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+std::uint64_t LatencyHistogram::quantile_ns(double q) const {
+    // Totals from the buckets themselves so a concurrent record() cannot push the target past the end.
+    std::uint64_t total = 0;
+    for (const auto& b : buckets_) total += b.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+    const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= target) return std::min(bucket_upper(i), max_ns());
+    }
+    return max_ns();
+}
+
+void CallbackTimer::reset() {
+    compute_.reset();
+    jitter_.reset();
+    for (auto& s : stage_ns_) s.store(0, std::memory_order_relaxed);
+    marked_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    min_headroom_ns_.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+    max_period_ns_.store(0, std::memory_order_relaxed);
+    period_ns_ = 0;
+    started_ = false;
+}
+
+void CallbackTimer::end() {
+    const std::int64_t compute = std::chrono::duration_cast<std::chrono::nanoseconds>(mark_ - start_).count();
+    compute_.record(static_cast<std::uint64_t>(std::max<std::int64_t>(compute, 0)));
+    const std::int64_t headroom = period_ns_ - compute;
+    if (headroom < min_headroom_ns_.load(std::memory_order_relaxed)) min_headroom_ns_.store(headroom, std::memory_order_relaxed);
+    if (headroom < 0) misses_.store(misses_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void CallbackTimer::fill(CallbackTiming& out) const {
+    constexpr double kUs = 1e-3;
+    const auto n = compute_.count();
+    out.deadline_misses = misses_.load(std::memory_order_relaxed);
+    out.period_us = static_cast<double>(max_period_ns_.load(std::memory_order_relaxed)) * kUs;
+    out.compute_mean_us = compute_.mean_ns() * kUs;
+    out.compute_p50_us = static_cast<double>(compute_.quantile_ns(0.50)) * kUs;
+    out.compute_p99_us = static_cast<double>(compute_.quantile_ns(0.99)) * kUs;
+    out.compute_max_us = static_cast<double>(compute_.max_ns()) * kUs;
+    out.min_headroom_us = n > 0 ? static_cast<double>(min_headroom_ns_.load(std::memory_order_relaxed)) * kUs : 0.0;
+    out.jitter_p99_us = static_cast<double>(jitter_.quantile_ns(0.99)) * kUs;
+    out.jitter_max_us = static_cast<double>(jitter_.max_ns()) * kUs;
+    const std::uint32_t marked = marked_.load(std::memory_order_relaxed);
+    for (std::size_t s = 0; s < kDspStages; ++s) {
+        if (n == 0) out.stage_mean_us[s] = 0.0;
+        else if ((marked >> s & 1U) == 0) out.stage_mean_us[s] = std::numeric_limits<double>::quiet_NaN();
+        else out.stage_mean_us[s] = static_cast<double>(stage_ns_[s].load(std::memory_order_relaxed)) * kUs / static_cast<double>(n);
+    }
+}
+
+} // namespace sonarlock::core
@@ -0,0 +1,122 @@
+#include "sonarlock/core/capture_recorder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace sonarlock::core {
+
+namespace {
+constexpr std::size_t kHeaderBytes = 4096;
+constexpr std::size_t kChunkBytes = 64 * 1024;
+constexpr std::uint32_t kUnknownSize = 0xFFFFFFFFU;
+
+void put(std::uint8_t* p, std::uint32_t v, int n) {
+    for (int i = 0; i < n; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+// RIFF/WAVE float32 header: fmt (18 bytes incl. cbSize), JUNK padding, data chunk ending at kHeaderBytes.
+std::array<std::uint8_t, kHeaderBytes> wav_header(double sample_rate_hz, std::size_t channels, std::uint32_t riff_size,
+                                                  std::uint32_t data_size) {
+    std::array<std::uint8_t, kHeaderBytes> h{};
+    const auto rate = static_cast<std::uint32_t>(sample_rate_hz);
+    const auto block_align = static_cast<std::uint32_t>(channels * sizeof(float));
+    std::memcpy(h.data(), "RIFF", 4);
+    put(h.data() + 4, riff_size, 4);
+    std::memcpy(h.data() + 8, "WAVEfmt ", 8);
+    put(h.data() + 16, 18, 4);
+    put(h.data() + 20, 3, 2); // IEEE float
+    put(h.data() + 22, static_cast<std::uint32_t>(channels), 2);
+    put(h.data() + 24, rate, 4);
+    put(h.data() + 28, rate * block_align, 4);
+    put(h.data() + 32, block_align, 2);
+    put(h.data() + 34, 32, 2);
+    put(h.data() + 36, 0, 2);
+    std::memcpy(h.data() + 38, "JUNK", 4);
+    put(h.data() + 42, static_cast<std::uint32_t>(kHeaderBytes - 8 - 46), 4);
+    std::memcpy(h.data() + kHeaderBytes - 8, "data", 4);
+    put(h.data() + kHeaderBytes - 4, data_size, 4);
+    return h;
+}
+} // namespace
+
+CaptureRecorder::~CaptureRecorder() { close(); }
+
+Status CaptureRecorder::open(const std::string& path, double sample_rate_hz, std::size_t channels, std::size_t block_frames,
+                             std::size_t ring_blocks) {
+    close();
+    if (channels == 0 || block_frames == 0 || sample_rate_hz <= 0.0) {
+        return Status::error(kErrInvalidArgument, "invalid recorder configuration");
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return Status::error(kErrInvalidArgument, "cannot create recording: " + path);
+    std::setvbuf(file_, nullptr, _IONBF, 0); // chunks are already large
+    const auto header = wav_header(sample_rate_hz, channels, kUnknownSize, kUnknownSize);
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return Status::error(kErrInvalidArgument, "cannot write recording: " + path);
+    }
+
+    channels_ = channels;
+    // Whole 4 KiB pages, at most half the ring so the writer starts before the ring fills.
+    const std::size_t page = 4096 / sizeof(float);
+    const std::size_t block = block_frames * channels;
+    ring_.reserve(std::max(block * std::max<std::size_t>(ring_blocks, 2), 2 * page));
+    const std::size_t chunk = std::min(kChunkBytes / sizeof(float), ring_.capacity() / 2) / page * page;
+    samples_written_ = 0;
+    // The tail drained by stop() is shorter but still whole frames: push only ever adds whole frames.
+    ring_.start(chunk, std::chrono::milliseconds(2), [this](std::span<const float> samples) { return write(samples); });
+    return Status::success();
+}
+
+void CaptureRecorder::push(std::span<const float> samples) { ring_.push(samples); }
+
+bool CaptureRecorder::write(std::span<const float> samples) {
+    if (std::fwrite(samples.data(), sizeof(float), samples.size(), file_) != samples.size()) return false;
+    samples_written_ += samples.size();
+    return true;
+}
+
+Status CaptureRecorder::close() {
+    if (!file_) return Status::success();
+    ring_.stop();
+
+    const std::uint64_t data_bytes = samples_written_ * sizeof(float);
+    const auto clamp32 = [](std::uint64_t v) { return static_cast<std::uint32_t>(std::min<std::uint64_t>(v, kUnknownSize)); };
+    const auto header = wav_header(0.0, channels_, clamp32(kHeaderBytes - 8 + data_bytes), clamp32(data_bytes));
+    // Only the two size fields change; the rest of the header was written in open().
+    bool ok = !ring_.failed();
+    ok = ok && std::fseek(file_, 4, SEEK_SET) == 0 && std::fwrite(header.data() + 4, 1, 4, file_) == 4;
+    ok = ok && std::fseek(file_, static_cast<long>(kHeaderBytes - 4), SEEK_SET) == 0 &&
+         std::fwrite(header.data() + kHeaderBytes - 4, 1, 4, file_) == 4;
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok ? Status::success() : Status::error(kErrStreamFailure, "recording incomplete: write failed");
+}
+
+Status CaptureTap::open(const AudioConfig& config) {
+    const auto& a = config.audio;
+    if (a.record_path.empty()) return Status::success();
+    auto st = input_.open(a.record_path, a.sample_rate_hz, a.input_channels, a.frames_per_buffer, a.record_ring_blocks);
+    if (st.ok() && a.record_tx) {
+        const auto tx_path = std::filesystem::path(a.record_path).replace_extension(".tx.wav").string();
+        st = tx_.open(tx_path, a.sample_rate_hz, 1, a.frames_per_buffer, a.record_ring_blocks);
+    }
+    if (!st.ok()) input_.close();
+    return st;
+}
+
+Status CaptureTap::close(RuntimeMetrics& metrics) {
+    if (!input_.is_open()) return Status::success();
+    auto st = input_.close();
+    const auto tx_st = tx_.close();
+    if (st.ok()) st = tx_st;
+    metrics.recorded_frames = input_.frames_written();
+    metrics.record_dropped_blocks = input_.dropped_blocks() + tx_.dropped_blocks();
+    return st;
+}
+
+} // namespace sonarlock::core
@@ -0,0 +1,117 @@
+#include "sonarlock/core/doppler_spectrogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sonarlock::core {
+
+namespace {
+constexpr double kTwoPi = 6.28318530717958647692;
+constexpr double kSpeedOfSoundMps = 343.0;
+} // namespace
+
+void DopplerSpectrogram::configure(double input_rate_hz, const AudioConfig& config) {
+    const auto& dsp = config.dsp;
+    size_ = 0;
+    if (dsp.stft_size < 4 || input_rate_hz <= 0.0) return;
+
+    plan_ = FftPlan(dsp.stft_size);
+    size_ = plan_.size();
+    hop_ = std::clamp<std::size_t>(dsp.stft_hop, 1, size_);
+    decimation_ = dsp.stft_rate_hz > 0.0
+                      ? std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(input_rate_hz / dsp.stft_rate_hz)))
+                      : 1;
+    rate_hz_ = input_rate_hz / static_cast<double>(decimation_);
+    velocity_per_hz_ = config.audio.f0_hz > 0.0 ? kSpeedOfSoundMps / (2.0 * config.audio.f0_hz) : 0.0;
+    band_low_hz_ = dsp.doppler_band_low_hz;
+    band_high_hz_ = dsp.doppler_band_high_hz;
+
+    window_.resize(size_);
+    double energy = 0.0;
+    for (std::size_t k = 0; k < size_; ++k) {
+        window_[k] = 0.5 - 0.5 * std::cos(kTwoPi * static_cast<double>(k) / static_cast<double>(size_));
+        energy += window_[k] * window_[k];
+    }
+    power_scale_ = 1.0 / (static_cast<double>(size_) * energy); // per-bin mean power of the frame
+    history_.assign(size_, {});
+    frame_.assign(size_, {});
+    spectrum_.assign(size_, 0.0);
+    write_ = 0;
+    filled_ = 0;
+    since_frame_ = 0;
+    acc_ = {};
+    acc_count_ = 0;
+    peak_hz_ = spread_hz_ = approach_ = recede_ = 0.0;
+}
+
+std::size_t DopplerSpectrogram::push(std::span<const double> i, std::span<const double> q) {
+    if (size_ == 0) return 0;
+    std::size_t frames = 0;
+    for (std::size_t k = 0; k < i.size(); ++k) {
+        acc_ += std::complex<double>(i[k], q[k]);
+        if (++acc_count_ < decimation_) continue;
+        history_[write_] = acc_ / static_cast<double>(decimation_);
+        write_ = (write_ + 1) % size_;
+        acc_ = {};
+        acc_count_ = 0;
+        filled_ = std::min(filled_ + 1, size_);
+        if (++since_frame_ >= hop_ && filled_ == size_) {
+            since_frame_ = 0;
+            analyze();
+            ++frames;
+        }
+    }
+    return frames;
+}
+
+void DopplerSpectrogram::analyze() {
+    for (std::size_t k = 0; k < size_; ++k) frame_[k] = history_[(write_ + k) % size_] * window_[k];
+    plan_.forward(frame_);
+
+    const std::size_t half = size_ / 2;
+    const double bin_hz = rate_hz_ / static_cast<double>(size_);
+    double total = 0.0;
+    double moment = 0.0;
+    double peak_power = 0.0;
+    approach_ = 0.0;
+    recede_ = 0.0;
+    peak_hz_ = 0.0;
+    for (std::size_t k = 0; k < size_; ++k) {
+        const double p = std::norm(frame_[k]) * power_scale_;
+        const std::size_t centred = (k + half) % size_;
+        spectrum_[centred] = p;
+
+        const double f = (static_cast<double>(centred) - static_cast<double>(half)) * bin_hz;
+        const double af = std::abs(f);
+        if (af < band_low_hz_ || af > band_high_hz_) continue;
+        (f > 0.0 ? approach_ : recede_) += p;
+        total += p;
+        moment += p * f;
+        if (p > peak_power) {
+            peak_power = p;
+            peak_hz_ = f;
+        }
+    }
+
+    spread_hz_ = 0.0;
+    if (total > 0.0) {
+        const double centroid = moment / total;
+        double var = 0.0;
+        for (std::size_t c = 0; c < size_; ++c) {
+            const double f = (static_cast<double>(c) - static_cast<double>(half)) * bin_hz;
+            const double af = std::abs(f);
+            if (af >= band_low_hz_ && af <= band_high_hz_) var += spectrum_[c] * (f - centroid) * (f - centroid);
+        }
+        spread_hz_ = std::sqrt(var / total);
+    }
+}
+
+void DopplerSpectrogram::fill(MotionFeatures& features) const {
+    features.doppler_peak_hz = peak_hz_;
+    features.radial_velocity_mps = peak_hz_ * velocity_per_hz_;
+    features.doppler_spread_hz = spread_hz_;
+    features.approach_energy = approach_;
+    features.recede_energy = recede_;
+}
+
+} // namespace sonarlock::core
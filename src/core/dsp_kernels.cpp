@@ -0,0 +1,521 @@
+#include "sonarlock/core/dsp_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SONARLOCK_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SONARLOCK_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(SONARLOCK_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SONARLOCK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SONARLOCK_TARGET_AVX2
+#endif
+
+namespace sonarlock::core::kernels {
+
+namespace {
+
+struct KernelTable {
+    InputStats (*input_stats)(const float*, std::size_t);
+    void (*mix)(const float*, const double*, const double*, double*, double*, std::size_t);
+    double (*magnitude)(const double*, const double*, double*, std::size_t);
+    double (*doppler_energy)(const double*, const float*, float, double, std::size_t);
+    void (*phase_step)(const double*, const double*, double, double, double*, std::size_t);
+};
+
+// ---- scalar reference ----
+
+InputStats input_stats_scalar(const float* x, std::size_t n) {
+    InputStats st;
+    for (std::size_t k = 0; k < n; ++k) {
+        st.peak = std::max(st.peak, std::abs(x[k]));
+        st.sum += x[k];
+        st.sum_sq += static_cast<double>(x[k]) * x[k];
+    }
+    return st;
+}
+
+void mix_scalar(const float* x, const double* c, const double* s, double* i_out, double* q_out, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) {
+        const double v = x[k];
+        i_out[k] = v * c[k];
+        q_out[k] = v * (-s[k]);
+    }
+}
+
+double magnitude_scalar(const double* i, const double* q, double* mag, std::size_t n) {
+    double acc = 0.0;
+    for (std::size_t k = 0; k < n; ++k) {
+        const double p = i[k] * i[k] + q[k] * q[k];
+        mag[k] = std::sqrt(p);
+        acc += p;
+    }
+    return acc;
+}
+
+double doppler_energy_scalar(const double* bp, const float* x, float prev_x, double gain, std::size_t n) {
+    double acc = 0.0;
+    double prev = prev_x;
+    for (std::size_t k = 0; k < n; ++k) {
+        const double cur = x[k];
+        const double v = bp[k] + gain * std::abs(cur - prev);
+        acc += v * v;
+        prev = cur;
+    }
+    return acc;
+}
+
+void phase_step_scalar(const double* i, const double* q, double prev_i, double prev_q, double* out, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) {
+        out[k] = fast_atan2(q[k] * prev_i - i[k] * prev_q, i[k] * prev_i + q[k] * prev_q);
+        prev_i = i[k];
+        prev_q = q[k];
+    }
+}
+
+constexpr KernelTable kScalarTable{input_stats_scalar, mix_scalar, magnitude_scalar,
+                                   doppler_energy_scalar, phase_step_scalar};
+
+#if defined(SONARLOCK_KERNELS_X86)
+
+// ---- SSE2 (baseline on x86-64) ----
+
+double hsum_sse2(__m128d v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+
+InputStats input_stats_sse2(const float* x, std::size_t n) {
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 peak = _mm_setzero_ps();
+    __m128d sum = _mm_setzero_pd();
+    __m128d sum_sq = _mm_setzero_pd();
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        const __m128 v = _mm_loadu_ps(x + k);
+        peak = _mm_max_ps(peak, _mm_and_ps(v, abs_mask));
+        const __m128d lo = _mm_cvtps_pd(v);
+        const __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        sum = _mm_add_pd(sum, _mm_add_pd(lo, hi));
+        sum_sq = _mm_add_pd(sum_sq, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, peak);
+    InputStats tail = input_stats_scalar(x + k, n - k);
+    tail.peak = std::max({tail.peak, lanes[0], lanes[1], lanes[2], lanes[3]});
+    tail.sum += hsum_sse2(sum);
+    tail.sum_sq += hsum_sse2(sum_sq);
+    return tail;
+}
+
+void mix_sse2(const float* x, const double* c, const double* s, double* i_out, double* q_out, std::size_t n) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    std::size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        const __m128d v = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + k))));
+        _mm_storeu_pd(i_out + k, _mm_mul_pd(v, _mm_loadu_pd(c + k)));
+        _mm_storeu_pd(q_out + k, _mm_mul_pd(v, _mm_xor_pd(_mm_loadu_pd(s + k), sign)));
+    }
+    mix_scalar(x + k, c + k, s + k, i_out + k, q_out + k, n - k);
+}
+
+double magnitude_sse2(const double* i, const double* q, double* mag, std::size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    std::size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        const __m128d vi = _mm_loadu_pd(i + k);
+        const __m128d vq = _mm_loadu_pd(q + k);
+        const __m128d p = _mm_add_pd(_mm_mul_pd(vi, vi), _mm_mul_pd(vq, vq));
+        _mm_storeu_pd(mag + k, _mm_sqrt_pd(p));
+        acc = _mm_add_pd(acc, p);
+    }
+    return hsum_sse2(acc) + magnitude_scalar(i + k, q + k, mag + k, n - k);
+}
+
+double doppler_energy_sse2(const double* bp, const float* x, float prev_x, double gain, std::size_t n) {
+    if (n == 0) return 0.0;
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d g = _mm_set1_pd(gain);
+    __m128d acc = _mm_setzero_pd();
+    const double v0 = bp[0] + gain * std::abs(static_cast<double>(x[0]) - static_cast<double>(prev_x));
+    std::size_t k = 1;
+    for (; k + 2 <= n; k += 2) {
+        const __m128d cur = _mm_set_pd(x[k + 1], x[k]);
+        const __m128d prev = _mm_set_pd(x[k], x[k - 1]);
+        const __m128d edge = _mm_and_pd(_mm_sub_pd(cur, prev), abs_mask);
+        const __m128d v = _mm_add_pd(_mm_loadu_pd(bp + k), _mm_mul_pd(g, edge));
+        acc = _mm_add_pd(acc, _mm_mul_pd(v, v));
+    }
+    double tail = 0.0;
+    if (k < n) tail = doppler_energy_scalar(bp + k, x + k, x[k - 1], gain, n - k);
+    return v0 * v0 + hsum_sse2(acc) + tail;
+}
+
+__m128d select_sse2(__m128d mask, __m128d a, __m128d b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+
+__m128d atan2_sse2(__m128d y, __m128d x) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d ax = _mm_andnot_pd(sign, x);
+    const __m128d ay = _mm_andnot_pd(sign, y);
+    __m128d t = _mm_div_pd(_mm_min_pd(ax, ay), _mm_max_pd(_mm_max_pd(ax, ay), _mm_set1_pd(1e-300)));
+    const __m128d reduce = _mm_cmpgt_pd(t, _mm_set1_pd(kTanPi8));
+    t = select_sse2(reduce, _mm_div_pd(_mm_sub_pd(t, one), _mm_add_pd(t, one)), t);
+    const __m128d s = _mm_mul_pd(t, t);
+    __m128d p = _mm_set1_pd(kAtanPoly[6]);
+    for (int k = 5; k >= 0; --k) p = _mm_add_pd(_mm_mul_pd(p, s), _mm_set1_pd(kAtanPoly[k]));
+    __m128d a = _mm_add_pd(_mm_mul_pd(t, p), _mm_and_pd(reduce, _mm_set1_pd(kPiOver4)));
+    a = select_sse2(_mm_cmpgt_pd(ay, ax), _mm_sub_pd(_mm_set1_pd(kPiOver2), a), a);
+    a = select_sse2(_mm_cmplt_pd(x, zero), _mm_sub_pd(_mm_set1_pd(kPi), a), a);
+    return _mm_xor_pd(a, _mm_and_pd(_mm_cmplt_pd(y, zero), sign));
+}
+
+void phase_step_sse2(const double* i, const double* q, double prev_i, double prev_q, double* out, std::size_t n) {
+    if (n == 0) return;
+    phase_step_scalar(i, q, prev_i, prev_q, out, 1);
+    std::size_t k = 1;
+    for (; k + 2 <= n; k += 2) {
+        const __m128d ci = _mm_loadu_pd(i + k);
+        const __m128d cq = _mm_loadu_pd(q + k);
+        const __m128d pi = _mm_loadu_pd(i + k - 1);
+        const __m128d pq = _mm_loadu_pd(q + k - 1);
+        const __m128d im = _mm_sub_pd(_mm_mul_pd(cq, pi), _mm_mul_pd(ci, pq));
+        const __m128d re = _mm_add_pd(_mm_mul_pd(ci, pi), _mm_mul_pd(cq, pq));
+        _mm_storeu_pd(out + k, atan2_sse2(im, re));
+    }
+    if (k < n) phase_step_scalar(i + k, q + k, i[k - 1], q[k - 1], out + k, n - k);
+}
+
+constexpr KernelTable kSse2Table{input_stats_sse2, mix_sse2, magnitude_sse2,
+                                 doppler_energy_sse2, phase_step_sse2};
+
+// ---- AVX2 ----
+
+SONARLOCK_TARGET_AVX2 double hsum_avx(__m256d v) {
+    const __m128d lo = _mm256_castpd256_pd128(v);
+    const __m128d hi = _mm256_extractf128_pd(v, 1);
+    return hsum_sse2(_mm_add_pd(lo, hi));
+}
+
+SONARLOCK_TARGET_AVX2 InputStats input_stats_avx2(const float* x, std::size_t n) {
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 peak = _mm256_setzero_ps();
+    __m256d sum = _mm256_setzero_pd();
+    __m256d sum_sq = _mm256_setzero_pd();
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const __m256 v = _mm256_loadu_ps(x + k);
+        peak = _mm256_max_ps(peak, _mm256_and_ps(v, abs_mask));
+        const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        sum = _mm256_add_pd(sum, _mm256_add_pd(lo, hi));
+        sum_sq = _mm256_add_pd(sum_sq, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, peak);
+    InputStats tail = input_stats_scalar(x + k, n - k);
+    for (float l : lanes) tail.peak = std::max(tail.peak, l);
+    tail.sum += hsum_avx(sum);
+    tail.sum_sq += hsum_avx(sum_sq);
+    return tail;
+}
+
+SONARLOCK_TARGET_AVX2 void mix_avx2(const float* x, const double* c, const double* s, double* i_out, double* q_out,
+                                    std::size_t n) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        const __m256d v = _mm256_cvtps_pd(_mm_loadu_ps(x + k));
+        _mm256_storeu_pd(i_out + k, _mm256_mul_pd(v, _mm256_loadu_pd(c + k)));
+        _mm256_storeu_pd(q_out + k, _mm256_mul_pd(v, _mm256_xor_pd(_mm256_loadu_pd(s + k), sign)));
+    }
+    mix_scalar(x + k, c + k, s + k, i_out + k, q_out + k, n - k);
+}
+
+SONARLOCK_TARGET_AVX2 double magnitude_avx2(const double* i, const double* q, double* mag, std::size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        const __m256d vi = _mm256_loadu_pd(i + k);
+        const __m256d vq = _mm256_loadu_pd(q + k);
+        const __m256d p = _mm256_add_pd(_mm256_mul_pd(vi, vi), _mm256_mul_pd(vq, vq));
+        _mm256_storeu_pd(mag + k, _mm256_sqrt_pd(p));
+        acc = _mm256_add_pd(acc, p);
+    }
+    return hsum_avx(acc) + magnitude_scalar(i + k, q + k, mag + k, n - k);
+}
+
+SONARLOCK_TARGET_AVX2 double doppler_energy_avx2(const double* bp, const float* x, float prev_x, double gain,
+                                                 std::size_t n) {
+    if (n == 0) return 0.0;
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d g = _mm256_set1_pd(gain);
+    __m256d acc = _mm256_setzero_pd();
+    const double v0 = bp[0] + gain * std::abs(static_cast<double>(x[0]) - static_cast<double>(prev_x));
+    std::size_t k = 1;
+    for (; k + 4 <= n; k += 4) {
+        const __m256d cur = _mm256_cvtps_pd(_mm_loadu_ps(x + k));
+        const __m256d prev = _mm256_cvtps_pd(_mm_loadu_ps(x + k - 1));
+        const __m256d edge = _mm256_and_pd(_mm256_sub_pd(cur, prev), abs_mask);
+        const __m256d v = _mm256_add_pd(_mm256_loadu_pd(bp + k), _mm256_mul_pd(g, edge));
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(v, v));
+    }
+    double tail = 0.0;
+    if (k < n) tail = doppler_energy_scalar(bp + k, x + k, x[k - 1], gain, n - k);
+    return v0 * v0 + hsum_avx(acc) + tail;
+}
+
+SONARLOCK_TARGET_AVX2 __m256d atan2_avx2(__m256d y, __m256d x) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d ax = _mm256_andnot_pd(sign, x);
+    const __m256d ay = _mm256_andnot_pd(sign, y);
+    __m256d t = _mm256_div_pd(_mm256_min_pd(ax, ay), _mm256_max_pd(_mm256_max_pd(ax, ay), _mm256_set1_pd(1e-300)));
+    const __m256d reduce = _mm256_cmp_pd(t, _mm256_set1_pd(kTanPi8), _CMP_GT_OQ);
+    t = _mm256_blendv_pd(t, _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one)), reduce);
+    const __m256d s = _mm256_mul_pd(t, t);
+    __m256d p = _mm256_set1_pd(kAtanPoly[6]);
+    for (int k = 5; k >= 0; --k) p = _mm256_add_pd(_mm256_mul_pd(p, s), _mm256_set1_pd(kAtanPoly[k]));
+    __m256d a = _mm256_add_pd(_mm256_mul_pd(t, p), _mm256_and_pd(reduce, _mm256_set1_pd(kPiOver4)));
+    a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(kPiOver2), a), _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+    a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(kPi), a), _mm256_cmp_pd(x, zero, _CMP_LT_OQ));
+    return _mm256_xor_pd(a, _mm256_and_pd(_mm256_cmp_pd(y, zero, _CMP_LT_OQ), sign));
+}
+
+SONARLOCK_TARGET_AVX2 void phase_step_avx2(const double* i, const double* q, double prev_i, double prev_q, double* out,
+                                           std::size_t n) {
+    if (n == 0) return;
+    phase_step_scalar(i, q, prev_i, prev_q, out, 1);
+    std::size_t k = 1;
+    for (; k + 4 <= n; k += 4) {
+        const __m256d ci = _mm256_loadu_pd(i + k);
+        const __m256d cq = _mm256_loadu_pd(q + k);
+        const __m256d pi = _mm256_loadu_pd(i + k - 1);
+        const __m256d pq = _mm256_loadu_pd(q + k - 1);
+        const __m256d im = _mm256_sub_pd(_mm256_mul_pd(cq, pi), _mm256_mul_pd(ci, pq));
+        const __m256d re = _mm256_add_pd(_mm256_mul_pd(ci, pi), _mm256_mul_pd(cq, pq));
+        _mm256_storeu_pd(out + k, atan2_avx2(im, re));
+    }
+    _mm256_zeroupper(); // GCC may turn the tail into a sibcall without its own vzeroupper
+    if (k < n) phase_step_scalar(i + k, q + k, i[k - 1], q[k - 1], out + k, n - k);
+}
+
+constexpr KernelTable kAvx2Table{input_stats_avx2, mix_avx2, magnitude_avx2,
+                                 doppler_energy_avx2, phase_step_avx2};
+
+bool cpu_has_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4]{};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#elif defined(SONARLOCK_KERNELS_NEON)
+
+// ---- NEON (baseline on aarch64) ----
+
+InputStats input_stats_neon(const float* x, std::size_t n) {
+    float32x4_t peak = vdupq_n_f32(0.0F);
+    float64x2_t sum = vdupq_n_f64(0.0);
+    float64x2_t sum_sq = vdupq_n_f64(0.0);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        const float32x4_t v = vld1q_f32(x + k);
+        peak = vmaxq_f32(peak, vabsq_f32(v));
+        const float64x2_t lo = vcvt_f64_f32(vget_low_f32(v));
+        const float64x2_t hi = vcvt_high_f64_f32(v);
+        sum = vaddq_f64(sum, vaddq_f64(lo, hi));
+        sum_sq = vaddq_f64(sum_sq, vaddq_f64(vmulq_f64(lo, lo), vmulq_f64(hi, hi)));
+    }
+    InputStats tail = input_stats_scalar(x + k, n - k);
+    tail.peak = std::max(tail.peak, vmaxvq_f32(peak));
+    tail.sum += vaddvq_f64(sum);
+    tail.sum_sq += vaddvq_f64(sum_sq);
+    return tail;
+}
+
+void mix_neon(const float* x, const double* c, const double* s, double* i_out, double* q_out, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        const float64x2_t v = vcvt_f64_f32(vld1_f32(x + k));
+        vst1q_f64(i_out + k, vmulq_f64(v, vld1q_f64(c + k)));
+        vst1q_f64(q_out + k, vmulq_f64(v, vnegq_f64(vld1q_f64(s + k))));
+    }
+    mix_scalar(x + k, c + k, s + k, i_out + k, q_out + k, n - k);
+}
+
+double magnitude_neon(const double* i, const double* q, double* mag, std::size_t n) {
+    float64x2_t acc = vdupq_n_f64(0.0);
+    std::size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        const float64x2_t vi = vld1q_f64(i + k);
+        const float64x2_t vq = vld1q_f64(q + k);
+        const float64x2_t p = vaddq_f64(vmulq_f64(vi, vi), vmulq_f64(vq, vq));
+        vst1q_f64(mag + k, vsqrtq_f64(p));
+        acc = vaddq_f64(acc, p);
+    }
+    return vaddvq_f64(acc) + magnitude_scalar(i + k, q + k, mag + k, n - k);
+}
+
+double doppler_energy_neon(const double* bp, const float* x, float prev_x, double gain, std::size_t n) {
+    if (n == 0) return 0.0;
+    const float64x2_t g = vdupq_n_f64(gain);
+    float64x2_t acc = vdupq_n_f64(0.0);
+    const double v0 = bp[0] + gain * std::abs(static_cast<double>(x[0]) - static_cast<double>(prev_x));
+    std::size_t k = 1;
+    for (; k + 2 <= n; k += 2) {
+        const float64x2_t cur = vcvt_f64_f32(vld1_f32(x + k));
+        const float64x2_t prev = vcvt_f64_f32(vld1_f32(x + k - 1));
+        const float64x2_t v = vaddq_f64(vld1q_f64(bp + k), vmulq_f64(g, vabsq_f64(vsubq_f64(cur, prev))));
+        acc = vaddq_f64(acc, vmulq_f64(v, v));
+    }
+    double tail = 0.0;
+    if (k < n) tail = doppler_energy_scalar(bp + k, x + k, x[k - 1], gain, n - k);
+    return v0 * v0 + vaddvq_f64(acc) + tail;
+}
+
+float64x2_t atan2_neon(float64x2_t y, float64x2_t x) {
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const float64x2_t ax = vabsq_f64(x);
+    const float64x2_t ay = vabsq_f64(y);
+    float64x2_t t = vdivq_f64(vminq_f64(ax, ay), vmaxq_f64(vmaxq_f64(ax, ay), vdupq_n_f64(1e-300)));
+    const uint64x2_t reduce = vcgtq_f64(t, vdupq_n_f64(kTanPi8));
+    t = vbslq_f64(reduce, vdivq_f64(vsubq_f64(t, one), vaddq_f64(t, one)), t);
+    const float64x2_t s = vmulq_f64(t, t);
+    float64x2_t p = vdupq_n_f64(kAtanPoly[6]);
+    for (int k = 5; k >= 0; --k) p = vaddq_f64(vmulq_f64(p, s), vdupq_n_f64(kAtanPoly[k]));
+    float64x2_t a = vaddq_f64(vmulq_f64(t, p), vbslq_f64(reduce, vdupq_n_f64(kPiOver4), zero));
+    a = vbslq_f64(vcgtq_f64(ay, ax), vsubq_f64(vdupq_n_f64(kPiOver2), a), a);
+    a = vbslq_f64(vcltq_f64(x, zero), vsubq_f64(vdupq_n_f64(kPi), a), a);
+    return vbslq_f64(vcltq_f64(y, zero), vnegq_f64(a), a);
+}
+
+void phase_step_neon(const double* i, const double* q, double prev_i, double prev_q, double* out, std::size_t n) {
+    if (n == 0) return;
+    phase_step_scalar(i, q, prev_i, prev_q, out, 1);
+    std::size_t k = 1;
+    for (; k + 2 <= n; k += 2) {
+        const float64x2_t ci = vld1q_f64(i + k);
+        const float64x2_t cq = vld1q_f64(q + k);
+        const float64x2_t pi = vld1q_f64(i + k - 1);
+        const float64x2_t pq = vld1q_f64(q + k - 1);
+        const float64x2_t im = vsubq_f64(vmulq_f64(cq, pi), vmulq_f64(ci, pq));
+        const float64x2_t re = vaddq_f64(vmulq_f64(ci, pi), vmulq_f64(cq, pq));
+        vst1q_f64(out + k, atan2_neon(im, re));
+    }
+    if (k < n) phase_step_scalar(i + k, q + k, i[k - 1], q[k - 1], out + k, n - k);
+}
+
+constexpr KernelTable kNeonTable{input_stats_neon, mix_neon, magnitude_neon,
+                                 doppler_energy_neon, phase_step_neon};
+
+#endif
+
+const KernelTable& table_for(SimdLevel level) {
+    switch (level) {
+#if defined(SONARLOCK_KERNELS_X86)
+    case SimdLevel::Avx2: return kAvx2Table;
+    case SimdLevel::Sse2: return kSse2Table;
+#elif defined(SONARLOCK_KERNELS_NEON)
+    case SimdLevel::Neon: return kNeonTable;
+#endif
+    default: return kScalarTable;
+    }
+}
+
+bool supported(SimdLevel level) {
+    if (level == SimdLevel::Scalar) return true;
+#if defined(SONARLOCK_KERNELS_X86)
+    if (level == SimdLevel::Sse2) return true;
+    if (level == SimdLevel::Avx2) return cpu_has_avx2();
+#elif defined(SONARLOCK_KERNELS_NEON)
+    if (level == SimdLevel::Neon) return true;
+#endif
+    return false;
+}
+
+std::atomic<const KernelTable*> g_table{nullptr};
+std::atomic<SimdLevel> g_level{SimdLevel::Scalar};
+
+const KernelTable& table() {
+    const KernelTable* t = g_table.load(std::memory_order_acquire);
+    if (t) return *t;
+    set_active_level(detected_level());
+    return *g_table.load(std::memory_order_acquire);
+}
+
+} // namespace
+
+SimdLevel detected_level() {
+    static const SimdLevel level = [] {
+        if (supported(SimdLevel::Avx2)) return SimdLevel::Avx2;
+        if (supported(SimdLevel::Sse2)) return SimdLevel::Sse2;
+        if (supported(SimdLevel::Neon)) return SimdLevel::Neon;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+SimdLevel active_level() {
+    (void)table();
+    return g_level.load(std::memory_order_relaxed);
+}
+
+void set_active_level(SimdLevel level) {
+    if (!supported(level)) level = SimdLevel::Scalar;
+    g_level.store(level, std::memory_order_relaxed);
+    g_table.store(&table_for(level), std::memory_order_release);
+}
+
+const char* level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::Sse2: return "sse2";
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Neon: return "neon";
+    }
+    return "unknown";
+}
+
+InputStats input_stats(std::span<const float> x) { return table().input_stats(x.data(), x.size()); }
+
+void mix(std::span<const float> x, std::span<const double> c, std::span<const double> s, std::span<double> i_out,
+         std::span<double> q_out) {
+    table().mix(x.data(), c.data(), s.data(), i_out.data(), q_out.data(), x.size());
+}
+
+double magnitude(std::span<const double> i, std::span<const double> q, std::span<double> mag_out) {
+    return table().magnitude(i.data(), q.data(), mag_out.data(), i.size());
+}
+
+double doppler_energy(std::span<const double> bp_mag, std::span<const float> x, float prev_x, double edge_gain) {
+    return table().doppler_energy(bp_mag.data(), x.data(), prev_x, edge_gain, x.size());
+}
+
+void phase_step(std::span<const double> i, std::span<const double> q, double prev_i, double prev_q,
+                std::span<double> out) {
+    table().phase_step(i.data(), q.data(), prev_i, prev_q, out.data(), i.size());
+}
+
+} // namespace sonarlock::core::kernels
@@ -1,11 +1,12 @@
 #include "sonarlock/core/dsp_pipeline.hpp"
 
+#include "sonarlock/core/dsp_kernels.hpp"
 #include "sonarlock/core/dsp_primitives.hpp"
 #include "sonarlock/core/sine_generator.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <sstream>
 
 namespace sonarlock::core {
 
@@ -24,102 +25,222 @@ void BasicDspPipeline::begin_session(const AudioConfig& config) {
 
     tx_generator_ = std::make_unique<SineGenerator>(config.audio.sample_rate_hz, config.audio.f0_hz);
     nco_ = std::make_unique<Nco>(config.audio.sample_rate_hz, config.audio.f0_hz);
-    i_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.lp_cutoff_hz);
-    q_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.lp_cutoff_hz);
-    i_dc_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.doppler_band_low_hz);
-    q_dc_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.doppler_band_low_hz);
-    i_band_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.doppler_band_high_hz);
-    q_band_lp_ = std::make_unique<IirLowPass>(config.audio.sample_rate_hz, config.dsp.doppler_band_high_hz);
-    phase_tracker_ = std::make_unique<PhaseTracker>();
+    const std::size_t channels = std::clamp<std::size_t>(config.audio.input_channels, 1, kMaxInputChannels);
+    metrics_.input_channels = channels;
+    const std::uint32_t factor = std::max<std::uint32_t>(config.dsp.decimation, 1);
+    baseband_rate_hz_ = config.audio.sample_rate_hz;
+    channels_.clear();
+    channels_.resize(channels);
+    for (auto& ch : channels_) {
+        if (factor > 1) {
+            ch.i_dec = std::make_unique<CicDecimator>(factor);
+            ch.q_dec = std::make_unique<CicDecimator>(factor);
+        }
+        ch.phase_diff = std::make_unique<PhaseDifferentiator>();
+    }
+    if (channels_.front().i_dec) baseband_rate_hz_ /= channels_.front().i_dec->factor();
+    const double step = config.audio.sample_rate_hz / baseband_rate_hz_;
+    signal_alpha_ = 1.0 - std::pow(0.995, step);
+    phase_alpha_ = 1.0 - std::pow(0.95, step);
+
+    const double bb_rate = baseband_rate_hz_;
+    if (config.dsp.filter_design == FilterDesign::Butterworth) {
+        baseband_lp_.configure(channels, {design_lowpass(bb_rate, config.dsp.lp_cutoff_hz)});
+        doppler_band_.configure(channels, {design_highpass(bb_rate, config.dsp.doppler_band_low_hz),
+                                           design_lowpass(bb_rate, config.dsp.doppler_band_high_hz)});
+    } else {
+        baseband_lp_.configure(channels, {design_one_pole_lowpass(bb_rate, config.dsp.lp_cutoff_hz)});
+        doppler_band_.configure(channels, {design_one_pole_highpass(bb_rate, config.dsp.doppler_band_low_hz),
+                                           design_one_pole_lowpass(bb_rate, config.dsp.doppler_band_high_hz)});
+    }
+    for (auto& ch : channels_) ch.spectrogram.configure(bb_rate, config);
     detector_ = std::make_unique<MotionDetector>(config.detection, std::make_unique<DefaultMotionScorer>());
     calibration_ = std::make_unique<CalibrationController>(config.calibration, config.detection);
     action_policy_ = std::make_unique<DefaultActionPolicy>();
     safety_ = std::make_unique<ActionSafetyController>(config.detection);
 
-    signal_ema_ = 1e-6;
-    noise_ema_ = 1e-6;
-    phase_velocity_ema_ = 0.0;
-    has_prev_input_ = false;
-    prev_input_ = 0.0;
-    journal_.push("{\"type\":\"session_start\"}");
+    reserve_scratch(std::max<std::size_t>(config.audio.frames_per_buffer, 1));
+    if (journal_.capacity() != config.logging.journal_capacity) journal_ = EventJournal(config.logging.journal_capacity);
+    journal_.clear();
+    journal_.push(JournalRecord{0.0, 0.0F, 0.0F, JournalEventKind::SessionStart});
+    timer_.reset();
+    published_.store(MetricsSnapshot::from(metrics_));
 }
 
 void BasicDspPipeline::process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) {
-    if (output.size() != input.size() || !nco_ || !tx_generator_) return;
-
-    tone_buffer_.assign(output.size(), 0.0F);
-    tx_generator_->generate(tone_buffer_, total_frames_, frame_offset);
-    std::copy(tone_buffer_.begin(), tone_buffer_.end(), output.begin());
-
-    double sum_sq = 0.0;
-    double sum = 0.0;
-    float peak = 0.0F;
-
-    double bb_sum_sq = 0.0;
-    double doppler_sum_sq = 0.0;
-    double phase_vel_sum = 0.0;
-    double last_unwrapped = 0.0;
-    bool has_last = false;
-
-    for (float sample : input) {
-        peak = std::max(peak, std::abs(sample));
-        sum_sq += static_cast<double>(sample) * sample;
-        sum += sample;
-
-        const auto [c, s] = nco_->next();
-        const double i = i_lp_->process(static_cast<double>(sample) * c);
-        const double q = q_lp_->process(static_cast<double>(sample) * (-s));
-
-        const double mag = std::sqrt(i * i + q * q);
-        bb_sum_sq += mag * mag;
-
-        const double i_bp = i_band_lp_->process(i - i_dc_lp_->process(i));
-        const double q_bp = q_band_lp_->process(q - q_dc_lp_->process(q));
-        const double bp_mag = std::sqrt(i_bp * i_bp + q_bp * q_bp);
-        double edge = 0.0;
-        if (has_prev_input_) edge = std::abs(static_cast<double>(sample) - prev_input_);
-        prev_input_ = sample;
-        has_prev_input_ = true;
-        doppler_sum_sq += (bp_mag + 0.05 * edge) * (bp_mag + 0.05 * edge);
-
-        const double unwrapped = phase_tracker_->unwrap(i, q);
-        if (has_last) {
-            const double vel = (unwrapped - last_unwrapped) * config_.audio.sample_rate_hz;
-            phase_velocity_ema_ = 0.95 * phase_velocity_ema_ + 0.05 * vel;
-            phase_vel_sum += std::abs(phase_velocity_ema_);
+    const std::size_t nch = channels_.size();
+    if (nch == 0 || input.size() != output.size() * nch || !nco_ || !tx_generator_) return;
+    // Scratch is sized in begin_session. A longer callback runs as several stride-sized updates
+    // instead of growing scratch on the audio thread.
+    std::size_t done = 0;
+    do {
+        const std::size_t n = std::min(stride_, output.size() - done);
+        process_update(input.subspan(done * nch, n * nch), output.subspan(done, n), frame_offset + done);
+        done += n;
+    } while (done < output.size());
+}
+
+void BasicDspPipeline::process_update(std::span<const float> input, std::span<float> output, std::size_t frame_offset) {
+    const std::size_t nch = channels_.size();
+    timer_.begin(output.size(), config_.audio.sample_rate_hz);
+
+    tx_generator_->generate(output, total_frames_, frame_offset);
+
+    const std::size_t frames = output.size();
+    const std::span<double> nco_cos(nco_cos_.data(), frames);
+    const std::span<double> nco_sin(nco_sin_.data(), frames);
+    const auto stats = kernels::input_stats(input);
+
+    // Mono input is read in place; interleaved input is split into channel rows once.
+    if (nch > 1) {
+        for (std::size_t k = 0; k < frames; ++k) {
+            for (std::size_t c = 0; c < nch; ++c) in_rows_[c * stride_ + k] = input[k * nch + c];
+        }
+    }
+    auto in_row = [&](std::size_t c) {
+        return nch == 1 ? input : std::span<const float>(in_rows_.data() + c * stride_, frames);
+    };
+    auto row = [&](std::vector<double>& buf, std::size_t c, std::size_t n) { return std::span<double>(buf.data() + c * stride_, n); };
+
+    // One NCO block serves every channel. Everything after the mixer runs on the baseband stream:
+    // one sample per input frame, or one per decimation factor frames with the decimators in place.
+    // The decimators of all channels advance in lock step, so m and first_out are shared.
+    nco_->fill(nco_cos, nco_sin);
+    std::size_t m = frames;
+    std::size_t first_out = 0;
+    for (std::size_t c = 0; c < nch; ++c) {
+        auto& ch = channels_[c];
+        const auto i_row = row(i_buf_, c, frames);
+        const auto q_row = row(q_buf_, c, frames);
+        kernels::mix(in_row(c), nco_cos, nco_sin, i_row, q_row);
+        if (ch.i_dec) {
+            first_out = ch.i_dec->next_output_offset();
+            m = ch.i_dec->process_block(i_row, i_row);
+            ch.q_dec->process_block(q_row, q_row);
+        }
+    }
+    timer_.mark(DspStage::Mix);
+
+    std::array<std::span<double>, kMaxInputChannels> i_bb{};
+    std::array<std::span<double>, kMaxInputChannels> q_bb{};
+    std::array<std::span<const double>, kMaxInputChannels> i_bb_in{};
+    std::array<std::span<const double>, kMaxInputChannels> q_bb_in{};
+    std::array<std::span<double>, kMaxInputChannels> i_bp{};
+    std::array<std::span<double>, kMaxInputChannels> q_bp{};
+    for (std::size_t c = 0; c < nch; ++c) {
+        i_bb[c] = row(i_buf_, c, m);
+        q_bb[c] = row(q_buf_, c, m);
+        i_bb_in[c] = i_bb[c];
+        q_bb_in[c] = q_bb[c];
+        i_bp[c] = row(i_bp_buf_, c, m);
+        q_bp[c] = row(q_bp_buf_, c, m);
+    }
+    const auto lanes = [nch](auto& rows) { return std::span(rows.data(), nch); };
+
+    baseband_lp_.process_block(lanes(i_bb_in), lanes(q_bb_in), lanes(i_bb), lanes(q_bb));
+    // Doppler band: strip the slow (DC) component, then limit to the upper band edge.
+    doppler_band_.process_block(lanes(i_bb_in), lanes(q_bb_in), lanes(i_bp), lanes(q_bp));
+    timer_.mark(DspStage::Filter);
+
+    constexpr double kEdgeGain = 0.05;
+    std::array<double, kMaxInputChannels> bb_sum_sq{};
+    std::array<double, kMaxInputChannels> doppler_sum_sq{};
+    for (std::size_t c = 0; c < nch; ++c) {
+        auto& ch = channels_[c];
+        const auto in = in_row(c);
+        const auto bp_mag = row(bp_mag_buf_, c, m);
+        bb_sum_sq[c] = kernels::magnitude(i_bb[c], q_bb[c], row(mag_buf_, c, m));
+        ch.spectrogram.push(i_bb[c], q_bb[c]);
+        kernels::magnitude(i_bp[c], q_bp[c], bp_mag);
+
+        if (frames > 0) {
+            const float prev = ch.has_prev_input ? ch.prev_input : in.front();
+            if (!ch.i_dec) {
+                doppler_sum_sq[c] = kernels::doppler_energy(bp_mag, in, prev, kEdgeGain);
+            } else {
+                // Edge term taken at the input frame each baseband sample is emitted at, which trails the
+                // sample's content by CicDecimator::group_delay().
+                for (std::size_t j = 0, idx = first_out; j < m; ++j, idx += ch.i_dec->factor()) {
+                    const float before = idx > 0 ? in[idx - 1] : prev;
+                    const double e = bp_mag[j] + kEdgeGain * std::abs(static_cast<double>(in[idx]) - before);
+                    doppler_sum_sq[c] += e * e;
+                }
+            }
+            ch.prev_input = in.back();
+            ch.has_prev_input = true;
         }
-        has_last = true;
-        last_unwrapped = unwrapped;
 
-        signal_ema_ = 0.995 * signal_ema_ + 0.005 * mag;
-        if (bp_mag < 0.01) noise_ema_ = 0.995 * noise_ema_ + 0.005 * mag;
+        ch.phase_diff->process_block(i_bb[c], q_bb[c], row(phase_step_buf_, c, m));
+    }
+
+    // The EMAs carry state sample to sample; walking the channels inside the sample loop overlaps
+    // their dependency chains. Velocity starts at the second sample of each block.
+    std::array<double, kMaxInputChannels> phase_vel_sum{};
+    std::array<double, kMaxInputChannels> signal_ema{};
+    std::array<double, kMaxInputChannels> noise_ema{};
+    std::array<double, kMaxInputChannels> phase_ema{};
+    for (std::size_t c = 0; c < nch; ++c) {
+        signal_ema[c] = channels_[c].signal_ema;
+        noise_ema[c] = channels_[c].noise_ema;
+        phase_ema[c] = channels_[c].phase_velocity_ema;
     }
+    for (std::size_t k = 0; k < m; ++k) {
+        for (std::size_t c = 0; c < nch; ++c) {
+            const std::size_t at = c * stride_ + k;
+            if (k > 0) {
+                const double vel = phase_step_buf_[at] * baseband_rate_hz_;
+                phase_ema[c] = (1.0 - phase_alpha_) * phase_ema[c] + phase_alpha_ * vel;
+                phase_vel_sum[c] += std::abs(phase_ema[c]);
+            }
 
-    const double n = static_cast<double>(input.size());
-    const double bb = n > 0.0 ? std::sqrt(bb_sum_sq / n) : 0.0;
-    const double dop = n > 0.0 ? std::sqrt(doppler_sum_sq / n) : 0.0;
+            signal_ema[c] = (1.0 - signal_alpha_) * signal_ema[c] + signal_alpha_ * mag_buf_[at];
+            if (bp_mag_buf_[at] < 0.01) noise_ema[c] = (1.0 - signal_alpha_) * noise_ema[c] + signal_alpha_ * mag_buf_[at];
+        }
+    }
 
+    // Block statistics over the baseband samples; a block too short to yield one keeps the last values.
     const bool motion_like = metrics_.latest_event.state == DetectionState::Observing ||
                              metrics_.latest_event.state == DetectionState::Triggered;
     const double alpha = motion_like ? config_.dsp.baseline_motion_alpha : config_.dsp.baseline_alpha;
-    metrics_.features.baseline_energy = (1.0 - alpha) * metrics_.features.baseline_energy + alpha * dop;
+    const double n = static_cast<double>(m);
+    std::size_t dominant = 0;
+    for (std::size_t c = 0; c < nch; ++c) {
+        auto& ch = channels_[c];
+        auto& f = ch.features;
+        ch.signal_ema = signal_ema[c];
+        ch.noise_ema = noise_ema[c];
+        ch.phase_velocity_ema = phase_ema[c];
 
-    metrics_.peak_level = std::max(metrics_.peak_level, peak);
-    metrics_.rms_level = n > 0.0 ? static_cast<float>(std::sqrt(sum_sq / n)) : 0.0F;
-    metrics_.dc_offset = n > 0.0 ? static_cast<float>(sum / n) : 0.0F;
-    metrics_.callbacks += 1;
-    metrics_.frames_processed += input.size();
+        const double bb = n > 0.0 ? std::sqrt(bb_sum_sq[c] / n) : f.baseband_energy;
+        const double dop = n > 0.0 ? std::sqrt(doppler_sum_sq[c] / n) : f.doppler_band_energy;
+        f.baseline_energy = (1.0 - alpha) * f.baseline_energy + alpha * dop;
+        f.baseband_energy = bb;
+        f.doppler_band_energy = dop;
+        f.phase_velocity = n > 1.0 ? phase_vel_sum[c] / n : f.phase_velocity;
+        f.snr_estimate = 20.0 * std::log10((ch.signal_ema + 1e-6) / (ch.noise_ema + 1e-6));
+        f.relative_motion = std::max(0.0, dop - f.baseline_energy);
+        ch.spectrogram.fill(f);
+        if (f.relative_motion > channels_[dominant].features.relative_motion) dominant = c;
+    }
 
-    metrics_.features.baseband_energy = bb;
-    metrics_.features.doppler_band_energy = dop;
-    metrics_.features.phase_velocity = n > 1.0 ? phase_vel_sum / n : 0.0;
-    metrics_.features.snr_estimate = 20.0 * std::log10((signal_ema_ + 1e-6) / (noise_ema_ + 1e-6));
-    metrics_.features.relative_motion = std::max(0.0, dop - metrics_.features.baseline_energy);
+    // Fusion: the channel seeing the most motion above its own baseline speaks for the array.
+    metrics_.features = channels_[dominant].features;
+    metrics_.dominant_channel = dominant;
+    metrics_.peak_level = std::max(metrics_.peak_level, stats.peak);
+    const double ns = static_cast<double>(input.size());
+    metrics_.rms_level = ns > 0.0 ? static_cast<float>(std::sqrt(stats.sum_sq / ns)) : 0.0F;
+    metrics_.dc_offset = ns > 0.0 ? static_cast<float>(stats.sum / ns) : 0.0F;
+    metrics_.callbacks += 1;
+    metrics_.frames_processed += frames;
+    timer_.mark(DspStage::Features);
 
-    const double ts = static_cast<double>(frame_offset + input.size()) / config_.audio.sample_rate_hz;
+    const double ts = static_cast<double>(frame_offset + frames) / config_.audio.sample_rate_hz;
     DetectionSection det_cfg = config_.detection;
-    calibration_->update(ts, metrics_.features.relative_motion, det_cfg);
+    calibration_->update(ts, metrics_.features.relative_motion, det_cfg, metrics_.latest_event.state);
     detector_->set_detection_config(det_cfg);
+    metrics_.trigger_threshold = det_cfg.trigger_threshold;
+    metrics_.release_threshold = det_cfg.release_threshold;
+    metrics_.threshold_updates = calibration_->threshold_updates();
 
     const auto ev = detector_->evaluate(metrics_.features, ts, calibration_->state());
     if (ev.state == DetectionState::Triggered) metrics_.triggered_count += 1;
@@ -127,15 +248,40 @@ void BasicDspPipeline::process(std::span<const float> input, std::span<float> ou
 
     const auto req = action_policy_->map(ev, config_.actions.mode);
     metrics_.latest_action = safety_->allow(req, config_.actions.manual_disable, ts) ? req : ActionRequest{};
+    timer_.mark(DspStage::Detect);
+
+    journal_.push(JournalRecord{ts, static_cast<float>(ev.score), static_cast<float>(metrics_.features.relative_motion),
+                                JournalEventKind::Update, ev.state, ev.calibration, metrics_.latest_action.type});
+    published_.store(MetricsSnapshot::from(metrics_));
+    timer_.mark(DspStage::Journal);
+    timer_.end();
+}
 
-    std::ostringstream os;
-    os << "{\"t\":" << ts << ",\"state\":" << static_cast<int>(ev.state)
-       << ",\"cal\":" << static_cast<int>(ev.calibration) << ",\"score\":" << ev.score
-       << ",\"rel\":" << metrics_.features.relative_motion << ",\"action\":" << static_cast<int>(metrics_.latest_action.type) << '}';
-    journal_.push(os.str());
+void BasicDspPipeline::reserve_scratch(std::size_t frames) {
+    // Kept across sessions, so a reused pipeline only grows its scratch.
+    const std::size_t rows = channels_.size() * std::max(stride_, frames);
+    if (stride_ >= frames && i_buf_.size() >= rows) return;
+    stride_ = std::max(stride_, frames);
+    nco_cos_.assign(stride_, 0.0);
+    nco_sin_.assign(stride_, 0.0);
+    in_rows_.assign(channels_.size() > 1 ? rows : 0, 0.0F);
+    for (auto* buf : {&i_buf_, &q_buf_, &i_bp_buf_, &q_bp_buf_, &mag_buf_, &bp_mag_buf_, &phase_step_buf_}) {
+        buf->assign(rows, 0.0);
+    }
+}
+
+RuntimeMetrics BasicDspPipeline::metrics() const {
+    RuntimeMetrics m = metrics_;
+    timer_.fill(m.timing);
+    return m;
 }
 
-RuntimeMetrics BasicDspPipeline::metrics() const { return metrics_; }
+RuntimeMetrics BasicDspPipeline::snapshot() const {
+    RuntimeMetrics m;
+    published_.load().apply_to(m);
+    timer_.fill(m.timing);
+    return m;
+}
 
 std::string BasicDspPipeline::dump_events_json(std::size_t n) const { return journal_.dump_json_array(n); }
 
@@ -1,23 +1,137 @@
 #include "sonarlock/core/dsp_primitives.hpp"
 
+#include "sonarlock/core/dsp_kernels.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace sonarlock::core {
 
 namespace {
 constexpr double kTwoPi = 6.28318530717958647692;
+
+constexpr int kLutBits = 12;
+constexpr std::size_t kLutSize = std::size_t{1} << kLutBits;
+constexpr std::uint64_t kQuarterTurn = std::uint64_t{1} << 62;
+
+const std::array<double, kLutSize + 1>& cos_table() {
+    static const auto table = [] {
+        std::array<double, kLutSize + 1> t{};
+        for (std::size_t k = 0; k <= kLutSize; ++k) t[k] = std::cos(kTwoPi * static_cast<double>(k) / kLutSize);
+        return t;
+    }();
+    return table;
+}
+
+// Maps a full-turn fixed-point phase to [0, 1) with 53 bits of precision.
+double turns(std::uint64_t phase) { return static_cast<double>(phase >> 11) * 0x1p-53; }
+
+double lut_cos(const std::array<double, kLutSize + 1>& t, std::uint64_t phase) {
+    const std::size_t idx = static_cast<std::size_t>(phase >> (64 - kLutBits));
+    const double frac = turns(phase << kLutBits);
+    return t[idx] + frac * (t[idx + 1] - t[idx]);
 }
+} // namespace
 
-Nco::Nco(double sample_rate_hz, double frequency_hz) : sample_rate_hz_(sample_rate_hz), frequency_hz_(frequency_hz) {}
+Nco::Nco(double sample_rate_hz, double frequency_hz, NcoMode mode) : mode_(mode), sample_rate_hz_(sample_rate_hz) {
+    set_frequency(frequency_hz);
+    if (mode_ == NcoMode::Lut) (void)cos_table();
+}
+
+void Nco::set_frequency(double frequency_hz) {
+    double cycles = frequency_hz / sample_rate_hz_;
+    cycles -= std::floor(cycles);
+    phase_inc_ = static_cast<std::uint64_t>(cycles * 0x1p63) << 1;
+    const double inc_rad = kTwoPi * turns(phase_inc_);
+    rot_c_ = std::cos(inc_rad);
+    rot_s_ = std::sin(inc_rad);
+    until_check_ = 0;
+}
+
+void Nco::reset() {
+    phase_ = 0;
+    z_c_ = 1.0;
+    z_s_ = 0.0;
+    until_check_ = 0;
+}
 
 std::pair<double, double> Nco::next() {
-    const auto c = std::cos(phase_);
-    const auto s = std::sin(phase_);
-    phase_ += kTwoPi * frequency_hz_ / sample_rate_hz_;
-    if (phase_ >= kTwoPi) phase_ -= kTwoPi;
+    double c = 0.0;
+    double s = 0.0;
+    fill(std::span<double>(&c, 1), std::span<double>(&s, 1));
     return {c, s};
 }
 
+void Nco::fill(std::span<double> cos_out, std::span<double> sin_out) {
+    const std::size_t n = std::min(cos_out.size(), sin_out.size());
+    std::size_t k = 0;
+    while (k < n) {
+        if (until_check_ == 0) check_phase();
+        const std::size_t m = std::min<std::size_t>(n - k, until_check_);
+        double* c = cos_out.data() + k;
+        double* s = sin_out.data() + k;
+        if (mode_ == NcoMode::Recurrence) {
+            double zc = z_c_;
+            double zs = z_s_;
+            for (std::size_t j = 0; j < m; ++j) {
+                c[j] = zc;
+                s[j] = zs;
+                const double nc = zc * rot_c_ - zs * rot_s_;
+                zs = zc * rot_s_ + zs * rot_c_;
+                zc = nc;
+            }
+            z_c_ = zc;
+            z_s_ = zs;
+            phase_ += phase_inc_ * m;
+        } else if (mode_ == NcoMode::Lut) {
+            const auto& t = cos_table();
+            for (std::size_t j = 0; j < m; ++j) {
+                c[j] = lut_cos(t, phase_);
+                s[j] = lut_cos(t, phase_ - kQuarterTurn);
+                phase_ += phase_inc_;
+            }
+        } else {
+            for (std::size_t j = 0; j < m; ++j) {
+                const double ph = phase_radians();
+                c[j] = std::cos(ph);
+                s[j] = std::sin(ph);
+                phase_ += phase_inc_;
+            }
+        }
+        k += m;
+        until_check_ -= static_cast<std::uint32_t>(m);
+    }
+}
+
+double Nco::phase_error_bound(NcoMode mode) {
+    // Lut: linear interpolation error (2*pi/4096)^2 / 8 ~ 2.9e-7, rounded up.
+    // Recurrence: a few ulp per rotation over kNcoCheckInterval steps, with generous margin.
+    if (mode == NcoMode::Lut) return 5e-7;
+    return 1e-11;
+}
+
+void Nco::check_phase() {
+    const double ph = phase_radians();
+    const double c = std::cos(ph);
+    const double s = std::sin(ph);
+    double gc = c;
+    double gs = s;
+    if (mode_ == NcoMode::Recurrence) {
+        gc = z_c_;
+        gs = z_s_;
+        z_c_ = c;
+        z_s_ = s;
+    } else if (mode_ == NcoMode::Lut) {
+        gc = lut_cos(cos_table(), phase_);
+        gs = lut_cos(cos_table(), phase_ - kQuarterTurn);
+    }
+    max_phase_error_ = std::max(max_phase_error_, std::abs(std::atan2(gs * c - gc * s, gc * c + gs * s)));
+    until_check_ = kNcoCheckInterval;
+}
+
+double Nco::phase_radians() const { return kTwoPi * turns(phase_); }
+
 IirLowPass::IirLowPass(double sample_rate_hz, double cutoff_hz) {
     const double rc = 1.0 / (kTwoPi * cutoff_hz);
     const double dt = 1.0 / sample_rate_hz;
@@ -29,6 +143,71 @@ double IirLowPass::process(double x) {
     return y_;
 }
 
+void IirLowPass::process_block(std::span<const double> in, std::span<double> out) {
+    double y = y_;
+    for (std::size_t k = 0; k < in.size(); ++k) {
+        y += alpha_ * (in[k] - y);
+        out[k] = y;
+    }
+    y_ = y;
+}
+
+namespace {
+constexpr double kCicInputScale = 0x1p30;
+} // namespace
+
+CicDecimator::CicDecimator(std::uint32_t factor) : factor_(std::clamp<std::uint32_t>(factor, 1, kMaxFactor)) {
+    const double r = static_cast<double>(factor_);
+    out_scale_ = 1.0 / (kCicInputScale * std::pow(r, kOrder));
+    // Flatten the CIC droop at an eighth of the output rate, where the Doppler band sits.
+    constexpr double kPi = 3.14159265358979323846;
+    const double w = kPi / 8.0; // half the angle at fs_out / 8
+    const double droop = factor_ > 1 ? std::pow(std::sin(w) / (r * std::sin(w / r)), kOrder) : 1.0;
+    comp_a_ = (1.0 / droop - 1.0) / (2.0 * (1.0 - std::cos(2.0 * w)));
+    reset();
+}
+
+void CicDecimator::reset() {
+    phase_ = 0;
+    integ_.fill(0);
+    comb_.fill(0);
+    fir_z1_ = 0.0;
+    fir_z2_ = 0.0;
+}
+
+std::size_t CicDecimator::process_block(std::span<const double> in, std::span<double> out) {
+    std::size_t produced = 0;
+    for (const double x : in) {
+        auto acc = static_cast<std::uint64_t>(static_cast<std::int64_t>(x * kCicInputScale));
+        for (auto& s : integ_) s = acc = s + acc;
+        if (++phase_ < factor_) continue;
+        phase_ = 0;
+
+        for (auto& z : comb_) {
+            const std::uint64_t prev = z;
+            z = acc;
+            acc -= prev;
+        }
+        const double y = static_cast<double>(static_cast<std::int64_t>(acc)) * out_scale_;
+        out[produced++] = (1.0 + 2.0 * comp_a_) * fir_z1_ - comp_a_ * (y + fir_z2_);
+        fir_z2_ = fir_z1_;
+        fir_z1_ = y;
+    }
+    return produced;
+}
+
+void PhaseDifferentiator::process_block(std::span<const double> i, std::span<const double> q, std::span<double> step_out) {
+    if (i.empty()) return;
+    kernels::phase_step(i, q, prev_i_, prev_q_, step_out);
+    prev_i_ = i.back();
+    prev_q_ = q.back();
+}
+
+void PhaseDifferentiator::reset() {
+    prev_i_ = 0.0;
+    prev_q_ = 0.0;
+}
+
 double PhaseTracker::unwrap(double i, double q) {
     const double wrapped = std::atan2(q, i);
     if (!initialized_) {
@@ -1,28 +1,68 @@
 #include "sonarlock/core/event_journal.hpp"
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
 
 namespace sonarlock::core {
 
-EventJournal::EventJournal(std::size_t capacity) : capacity_(capacity) {}
+namespace {
+void append(std::string& out, double v) {
+    char buf[32];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::general, 6);
+    out.append(buf, res.ptr);
+}
+
+void append(std::string& out, int v) {
+    char buf[16];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, res.ptr);
+}
+
+void append_record(std::string& out, const JournalRecord& r) {
+    if (r.kind == JournalEventKind::SessionStart) {
+        out += "{\"type\":\"session_start\"}";
+        return;
+    }
+    out += "{\"t\":";
+    append(out, r.timestamp_sec);
+    out += ",\"state\":";
+    append(out, static_cast<int>(r.state));
+    out += ",\"cal\":";
+    append(out, static_cast<int>(r.calibration));
+    out += ",\"score\":";
+    append(out, static_cast<double>(r.score));
+    out += ",\"rel\":";
+    append(out, static_cast<double>(r.relative_motion));
+    out += ",\"action\":";
+    append(out, static_cast<int>(r.action));
+    out += '}';
+}
+} // namespace
+
+EventJournal::EventJournal(std::size_t capacity) : records_(std::max<std::size_t>(capacity, 1)) {}
+
+void EventJournal::push(const JournalRecord& record) {
+    records_[(head_ + size_) % records_.size()] = record;
+    if (size_ < records_.size()) ++size_;
+    else head_ = (head_ + 1) % records_.size();
+}
 
-void EventJournal::push(std::string event_json_line) {
-    if (events_.size() >= capacity_) events_.pop_front();
-    events_.push_back(std::move(event_json_line));
+void EventJournal::copy_to(std::vector<JournalRecord>& out) const {
+    out.resize(size_);
+    for (std::size_t i = 0; i < size_; ++i) out[i] = records_[(head_ + i) % records_.size()];
 }
 
 std::string EventJournal::dump_json_array(std::size_t max_items) const {
-    std::ostringstream out;
-    out << '[';
-    const std::size_t start = (events_.size() > max_items) ? (events_.size() - max_items) : 0;
-    bool first = true;
-    for (std::size_t i = start; i < events_.size(); ++i) {
-        if (!first) out << ',';
-        first = false;
-        out << events_[i];
+    const std::size_t count = std::min(size_, max_items);
+    std::string out;
+    out.reserve(2 + count * 96);
+    out += '[';
+    for (std::size_t i = size_ - count; i < size_; ++i) {
+        if (i != size_ - count) out += ',';
+        append_record(out, records_[(head_ + i) % records_.size()]);
     }
-    out << ']';
-    return out.str();
+    out += ']';
+    return out;
 }
 
 } // namespace sonarlock::core
@@ -0,0 +1,251 @@
+#include "sonarlock/core/feature_trace.hpp"
+
+#include "sonarlock/core/action_policy.hpp"
+#include "sonarlock/core/calibration.hpp"
+#include "sonarlock/core/motion_detection.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+namespace sonarlock::core {
+
+namespace {
+constexpr std::array<char, 8> kMagic{'S', 'L', 'F', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint32_t kByteOrder = 0x01020304U;
+
+static_assert(std::is_trivially_copyable_v<FeatureTraceHeader> && sizeof(FeatureTraceHeader) <= kTraceHeaderBytes);
+static_assert(std::is_trivially_copyable_v<FeatureFrame>);
+
+constexpr const char* kColumnNames[kTraceColumns] = {
+    "timestamp_sec",   "baseband_energy",  "doppler_band_energy", "phase_velocity",   "snr_estimate",    "baseline_energy",
+    "relative_motion", "doppler_peak_hz",  "radial_velocity_mps", "doppler_spread_hz", "approach_energy", "recede_energy"};
+
+bool write_header(std::FILE* f, const FeatureTraceHeader& h) {
+    std::array<std::byte, kTraceHeaderBytes> buf{};
+    std::memcpy(buf.data(), &h, sizeof(h));
+    return std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+}
+} // namespace
+
+const char* trace_column_name(std::size_t column) { return column < kTraceColumns ? kColumnNames[column] : ""; }
+
+FeatureTraceHeader FeatureTraceHeader::from_config(const AudioConfig& config) {
+    FeatureTraceHeader h;
+    h.magic = kMagic;
+    h.byte_order = kByteOrder;
+    h.version = kTraceVersion;
+    h.columns = static_cast<std::uint32_t>(kTraceColumns);
+    h.block_rows = static_cast<std::uint32_t>(kTraceBlockRows);
+    h.rows = kTraceUnknownRows;
+    h.sample_rate_hz = config.audio.sample_rate_hz;
+    h.frames_per_buffer = config.audio.frames_per_buffer;
+    h.input_channels = config.audio.input_channels;
+    h.f0_hz = config.audio.f0_hz;
+    h.decimation = config.dsp.decimation;
+    h.filter_design = static_cast<std::uint32_t>(config.dsp.filter_design);
+    h.lp_cutoff_hz = config.dsp.lp_cutoff_hz;
+    h.doppler_band_low_hz = config.dsp.doppler_band_low_hz;
+    h.doppler_band_high_hz = config.dsp.doppler_band_high_hz;
+    h.baseline_alpha = config.dsp.baseline_alpha;
+    h.baseline_motion_alpha = config.dsp.baseline_motion_alpha;
+    h.stft_size = config.dsp.stft_size;
+    h.stft_hop = config.dsp.stft_hop;
+    h.stft_rate_hz = config.dsp.stft_rate_hz;
+    const auto& d = config.detection;
+    h.trigger_threshold = d.trigger_threshold;
+    h.release_threshold = d.release_threshold;
+    h.debounce_ms = d.debounce_ms;
+    h.cooldown_ms = d.cooldown_ms;
+    h.arming_delay_ms = d.arming_delay_ms;
+    h.lock_cooldown_ms = d.lock_cooldown_ms;
+    h.max_locks_per_minute = d.max_locks_per_minute;
+    const auto& c = config.calibration;
+    h.calibration_enabled = c.enabled ? 1U : 0U;
+    h.warmup_seconds = c.warmup_seconds;
+    h.calibrate_seconds = c.calibrate_seconds;
+    h.trigger_k = c.trigger_k;
+    h.release_k = c.release_k;
+    h.min_threshold = c.min_threshold;
+    h.max_threshold = c.max_threshold;
+    h.adapt = c.adapt ? 1U : 0U;
+    h.adapt_interval_seconds = c.adapt_interval_seconds;
+    h.adapt_window_seconds = c.adapt_window_seconds;
+    h.adapt_max_step = c.adapt_max_step;
+    h.action_mode = static_cast<std::uint32_t>(config.actions.mode);
+    h.manual_disable = config.actions.manual_disable ? 1U : 0U;
+    h.scenario = static_cast<std::uint32_t>(config.scenario);
+    h.seed = config.seed;
+    for (std::size_t i = 0; i < kTraceColumns; ++i) {
+        std::strncpy(h.column_names[i].data(), kColumnNames[i], h.column_names[i].size() - 1);
+    }
+    return h;
+}
+
+void FeatureTraceHeader::apply_to(AudioConfig& config) const {
+    config.audio.sample_rate_hz = sample_rate_hz;
+    config.audio.frames_per_buffer = frames_per_buffer;
+    config.audio.input_channels = input_channels;
+    config.audio.f0_hz = f0_hz;
+    config.dsp.decimation = decimation;
+    config.dsp.filter_design = static_cast<FilterDesign>(filter_design);
+    config.dsp.lp_cutoff_hz = lp_cutoff_hz;
+    config.dsp.doppler_band_low_hz = doppler_band_low_hz;
+    config.dsp.doppler_band_high_hz = doppler_band_high_hz;
+    config.dsp.baseline_alpha = baseline_alpha;
+    config.dsp.baseline_motion_alpha = baseline_motion_alpha;
+    config.dsp.stft_size = static_cast<std::size_t>(stft_size);
+    config.dsp.stft_hop = static_cast<std::size_t>(stft_hop);
+    config.dsp.stft_rate_hz = stft_rate_hz;
+    auto& d = config.detection;
+    d.trigger_threshold = trigger_threshold;
+    d.release_threshold = release_threshold;
+    d.debounce_ms = debounce_ms;
+    d.cooldown_ms = cooldown_ms;
+    d.arming_delay_ms = arming_delay_ms;
+    d.lock_cooldown_ms = lock_cooldown_ms;
+    d.max_locks_per_minute = max_locks_per_minute;
+    auto& c = config.calibration;
+    c.enabled = calibration_enabled != 0;
+    c.warmup_seconds = warmup_seconds;
+    c.calibrate_seconds = calibrate_seconds;
+    c.trigger_k = trigger_k;
+    c.release_k = release_k;
+    c.min_threshold = min_threshold;
+    c.max_threshold = max_threshold;
+    c.adapt = adapt != 0;
+    c.adapt_interval_seconds = adapt_interval_seconds;
+    c.adapt_window_seconds = adapt_window_seconds;
+    c.adapt_max_step = adapt_max_step;
+    config.actions.mode = static_cast<ActionMode>(action_mode);
+    config.actions.manual_disable = manual_disable != 0;
+    config.scenario = static_cast<FakeScenario>(scenario);
+    config.seed = seed;
+}
+
+FeatureTraceWriter::~FeatureTraceWriter() { close(); }
+
+Status FeatureTraceWriter::open(const std::string& path, const AudioConfig& config, std::size_t ring_rows) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return Status::error(kErrInvalidArgument, "cannot create feature trace: " + path);
+    header_ = FeatureTraceHeader::from_config(config);
+    if (!write_header(file_, header_)) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return Status::error(kErrInvalidArgument, "cannot write feature trace: " + path);
+    }
+    ring_.reserve(std::max(ring_rows, kTraceBlockRows));
+    columns_.assign(kTraceColumns * kTraceBlockRows, 0.0);
+    rows_written_ = 0;
+    ring_.start(kTraceBlockRows, std::chrono::milliseconds(5), [this](std::span<const FeatureFrame> rows) { return write_block(rows); });
+    return Status::success();
+}
+
+void FeatureTraceWriter::push(const FeatureFrame& frame) { ring_.push(std::span<const FeatureFrame>(&frame, 1)); }
+
+bool FeatureTraceWriter::write_block(std::span<const FeatureFrame> rows) {
+    const std::size_t n = rows.size();
+    for (std::size_t r = 0; r < n; ++r) columns_[r] = rows[r].timestamp_sec;
+    for (std::size_t c = 1; c < kTraceColumns; ++c) {
+        double* col = columns_.data() + c * n;
+        const auto field = kFeatureFields[c - 1];
+        for (std::size_t r = 0; r < n; ++r) col[r] = rows[r].features.*field;
+    }
+    const std::uint64_t count = n;
+    if (std::fwrite(&count, sizeof(count), 1, file_) != 1 ||
+        std::fwrite(columns_.data(), sizeof(double), kTraceColumns * n, file_) != kTraceColumns * n) {
+        return false;
+    }
+    rows_written_ += n;
+    return true;
+}
+
+Status FeatureTraceWriter::close() {
+    if (!file_) return Status::success();
+    ring_.stop();
+    header_.rows = rows_written_;
+    bool ok = !ring_.failed() && write_header(file_, header_);
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok ? Status::success() : Status::error(kErrStreamFailure, "feature trace incomplete: write failed");
+}
+
+void FeatureTap::begin_session(const AudioConfig& config) {
+    inner_.begin_session(config);
+    sample_rate_hz_ = config.audio.sample_rate_hz;
+    sink_.begin_session(config);
+}
+
+void FeatureTap::process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) {
+    inner_.process(input, output, frame_offset);
+    // Same timestamp the pipeline gives its detector.
+    sink_.push(FeatureFrame{static_cast<double>(frame_offset + output.size()) / sample_rate_hz_, inner_.features()});
+}
+
+Status FeatureTraceReader::open(const std::string& path) {
+    blocks_.clear();
+    rows_ = 0;
+    if (auto st = file_.open(path); !st.ok()) return st;
+    const auto bytes = file_.bytes();
+    if (bytes.size() < kTraceHeaderBytes) return Status::error(kErrInputFile, "not a feature trace: " + path);
+    std::memcpy(&header_, bytes.data(), sizeof(header_));
+    if (header_.magic != kMagic) return Status::error(kErrInputFile, "not a feature trace: " + path);
+    if (header_.byte_order != kByteOrder || header_.version != kTraceVersion || header_.columns != kTraceColumns) {
+        return Status::error(kErrInputFile, "unsupported feature trace version or byte order: " + path);
+    }
+
+    std::size_t at = kTraceHeaderBytes;
+    while (at + sizeof(std::uint64_t) <= bytes.size()) {
+        std::uint64_t n = 0;
+        std::memcpy(&n, bytes.data() + at, sizeof(n));
+        const std::size_t body = at + sizeof(n);
+        if (n == 0 || n > header_.block_rows || (bytes.size() - body) / (kTraceColumns * sizeof(double)) < n) break;
+        // Header and block sizes are multiples of 8, so columns are aligned within the page-aligned mapping.
+        blocks_.push_back(Block{static_cast<std::size_t>(n), reinterpret_cast<const double*>(bytes.data() + body)});
+        rows_ += n;
+        at = body + static_cast<std::size_t>(n) * kTraceColumns * sizeof(double);
+    }
+    return Status::success();
+}
+
+ReplayResult replay_trace(const FeatureTraceReader& trace, const AudioConfig& config) {
+    CalibrationController calibration(config.calibration, config.detection);
+    MotionDetector detector(config.detection, std::make_unique<DefaultMotionScorer>());
+    DefaultActionPolicy policy;
+    ActionSafetyController safety(config.detection);
+
+    ReplayResult out;
+    auto& m = out.metrics;
+    m.sample_rate_hz = config.audio.sample_rate_hz;
+    m.frames_per_buffer = config.audio.frames_per_buffer;
+    m.input_channels = config.audio.input_channels;
+    std::array<std::span<const double>, kTraceColumns> cols;
+    for (const auto& block : trace.blocks()) {
+        for (std::size_t c = 0; c < kTraceColumns; ++c) cols[c] = block.column(c);
+        for (std::size_t r = 0; r < block.rows; ++r) {
+            for (std::size_t c = 1; c < kTraceColumns; ++c) m.features.*kFeatureFields[c - 1] = cols[c][r];
+            const double ts = cols[0][r];
+
+            DetectionSection det = config.detection;
+            calibration.update(ts, m.features.relative_motion, det, m.latest_event.state);
+            detector.set_detection_config(det);
+            m.trigger_threshold = det.trigger_threshold;
+            m.release_threshold = det.release_threshold;
+
+            const auto ev = detector.evaluate(m.features, ts, calibration.state());
+            if (ev.state == DetectionState::Triggered) m.triggered_count += 1;
+            m.latest_event = ev;
+
+            const auto req = policy.map(ev, config.actions.mode);
+            m.latest_action = safety.allow(req, config.actions.manual_disable, ts) ? req : ActionRequest{};
+            if (m.latest_action.type != ActionType::None) out.actions += 1;
+        }
+        m.callbacks += block.rows;
+    }
+    m.threshold_updates = calibration.threshold_updates();
+    return out;
+}
+
+} // namespace sonarlock::core
@@ -0,0 +1,81 @@
+#include "sonarlock/core/fft.hpp"
+
+#include <cmath>
+#include <utility>
+
+namespace sonarlock::core {
+
+namespace {
+constexpr double kTwoPi = 6.28318530717958647692;
+
+// Plain complex product; operator* adds an Annex G NaN/inf recovery path we don't need.
+std::complex<double> cmul(std::complex<double> a, std::complex<double> b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+} // namespace
+
+FftPlan::FftPlan(std::size_t n) {
+    while (n_ < n) n_ <<= 1;
+    while ((std::size_t{1} << log2_) < n_) ++log2_;
+
+    bitrev_.resize(n_);
+    for (std::size_t k = 0; k < n_; ++k) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < log2_; ++b) r |= ((k >> b) & 1U) << (log2_ - 1 - b);
+        bitrev_[k] = r;
+    }
+    twiddle_.resize(n_);
+    for (std::size_t k = 0; k < n_; ++k) {
+        const double a = -kTwoPi * static_cast<double>(k) / static_cast<double>(n_);
+        twiddle_[k] = {std::cos(a), std::sin(a)};
+    }
+}
+
+void FftPlan::forward(std::span<std::complex<double>> data) const { transform(data, false); }
+
+void FftPlan::inverse(std::span<std::complex<double>> data) const { transform(data, true); }
+
+void FftPlan::transform(std::span<std::complex<double>> data, bool inverse) const {
+    using C = std::complex<double>;
+    if (data.size() != n_ || n_ < 2) return;
+    for (std::size_t k = 0; k < n_; ++k) {
+        if (k < bitrev_[k]) std::swap(data[k], data[bitrev_[k]]);
+    }
+    auto tw = [&](std::size_t idx) { return inverse ? std::conj(twiddle_[idx]) : twiddle_[idx]; };
+    // Multiplication by -i (forward) or +i (inverse).
+    auto rot = [&](C v) { return inverse ? C{-v.imag(), v.real()} : C{v.imag(), -v.real()}; };
+
+    std::size_t len = 1; // length of the sub-transforms already combined
+    if (log2_ % 2 == 1) {
+        for (std::size_t base = 0; base < n_; base += 2) {
+            const C a = data[base];
+            const C b = data[base + 1];
+            data[base] = a + b;
+            data[base + 1] = a - b;
+        }
+        len = 2;
+    }
+
+    // In bit-reversed order the four length-len blocks of each group hold residues 0, 2, 1, 3 (mod 4).
+    for (; len < n_; len *= 4) {
+        const std::size_t stride = n_ / (4 * len);
+        for (std::size_t base = 0; base < n_; base += 4 * len) {
+            for (std::size_t k = 0; k < len; ++k) {
+                const C a = data[base + k];
+                const C b = cmul(data[base + len + k], tw(2 * k * stride));
+                const C c = cmul(data[base + 2 * len + k], tw(k * stride));
+                const C d = cmul(data[base + 3 * len + k], tw(3 * k * stride));
+                const C t0 = a + b;
+                const C t1 = a - b;
+                const C t2 = c + d;
+                const C t3 = rot(c - d);
+                data[base + k] = t0 + t2;
+                data[base + len + k] = t1 + t3;
+                data[base + 2 * len + k] = t0 - t2;
+                data[base + 3 * len + k] = t1 - t3;
+            }
+        }
+    }
+}
+
+} // namespace sonarlock::core
@@ -1,52 +1,282 @@
 #include "sonarlock/core/logger.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
-#include <fstream>
-#include <iomanip>
-#include <iostream>
 #include <mutex>
-#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace sonarlock::core {
 
 namespace {
+
+constexpr std::size_t kSlotText = 480;
+constexpr std::string_view kTruncated = " ...[truncated]";
+// The writer wakes this often on its own; producers only wake it early past the high-water mark.
+constexpr auto kWriterInterval = std::chrono::milliseconds(50);
+
+struct LogSlot {
+    std::atomic<std::size_t> seq{0};
+    LogLevel level{LogLevel::Info};
+    std::chrono::system_clock::time_point time{};
+    std::size_t len{0};
+    bool more{false}; // the message continues in the next slot
+    char text[kSlotText]{};
+};
+
+// Bounded lock-free multi-producer queue (Vyukov); the writer thread is the only consumer. A message
+// longer than one slot claims consecutive slots in a single CAS.
+class LogQueue {
+  public:
+    explicit LogQueue(std::size_t min_capacity) {
+        std::size_t cap = 2;
+        while (cap < min_capacity) cap <<= 1;
+        slots_ = std::vector<LogSlot>(cap);
+        mask_ = cap - 1;
+        for (std::size_t i = 0; i < cap; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Returns the position after the message, or 0 when the queue has no room for it.
+    std::size_t try_push(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message) {
+        const std::size_t parts = std::max<std::size_t>(1, (message.size() + kSlotText - 1) / kSlotText);
+        std::size_t pos = enqueue_.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto diff = static_cast<std::ptrdiff_t>(slots_[pos & mask_].seq.load(std::memory_order_acquire)) -
+                              static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (!free_after(pos, parts)) return 0;
+                if (enqueue_.compare_exchange_weak(pos, pos + parts, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return 0;
+            } else {
+                pos = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+        for (std::size_t i = 0; i < parts; ++i) {
+            LogSlot& slot = slots_[(pos + i) & mask_];
+            const std::size_t offset = i * kSlotText;
+            slot.level = level;
+            slot.time = time;
+            slot.len = std::min(message.size() - offset, kSlotText);
+            slot.more = i + 1 < parts;
+            std::memcpy(slot.text, message.data() + offset, slot.len);
+            slot.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return pos + parts;
+    }
+
+    // Consumer only. Returns nullptr when the next slot is not published yet.
+    const LogSlot* front() const {
+        const LogSlot& slot = slots_[dequeue_ & mask_];
+        return slot.seq.load(std::memory_order_acquire) == dequeue_ + 1 ? &slot : nullptr;
+    }
+
+    void pop() {
+        slots_[dequeue_ & mask_].seq.store(dequeue_ + slots_.size(), std::memory_order_release);
+        ++dequeue_;
+    }
+
+    [[nodiscard]] std::size_t enqueued() const { return enqueue_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t capacity() const { return slots_.size(); }
+
+  private:
+    // Slots pos + 1 .. pos + parts - 1 are free for this lap (pos itself was checked by the caller).
+    bool free_after(std::size_t pos, std::size_t parts) const {
+        for (std::size_t i = 1; i < parts; ++i) {
+            if (slots_[(pos + i) & mask_].seq.load(std::memory_order_acquire) != pos + i) return false;
+        }
+        return true;
+    }
+
+    std::vector<LogSlot> slots_;
+    std::size_t mask_{0};
+    alignas(64) std::atomic<std::size_t> enqueue_{0};
+    alignas(64) std::size_t dequeue_{0};
+};
+
+const char* level_name(LogLevel level) {
+    return level == LogLevel::Warn ? "WARN" : (level == LogLevel::Error ? "ERROR" : "INFO");
+}
+
+// Producers only copy the message into queue slots. A writer thread wakes every kWriterInterval (or
+// early, past the high-water mark, on flush and on shutdown), formats timestamps and writes each
+// batch with one write per sink to stdout and a persistently open log file whose size is tracked
+// in memory for rotation.
 class ConsoleFileLogger final : public Logger {
   public:
-    explicit ConsoleFileLogger(LoggingSection cfg) : cfg_(std::move(cfg)) {}
+    explicit ConsoleFileLogger(LoggingSection cfg)
+        : cfg_(std::move(cfg)), queue_(cfg_.queue_capacity), high_water_(std::max<std::size_t>(1, queue_.capacity() / 4)),
+          max_message_(queue_.capacity() * kSlotText) {
+        open_file();
+        batch_.reserve(64 * 1024);
+        writer_ = std::thread([this] { run(); });
+    }
 
-    void write(LogLevel level, std::string_view message) override {
-        std::lock_guard<std::mutex> lock(mu_);
-        rotate_if_needed();
+    ~ConsoleFileLogger() override {
+        stop_.store(true, std::memory_order_release);
+        wake();
+        writer_.join();
+        if (file_) std::fclose(file_);
+    }
 
-        auto now = std::chrono::system_clock::now();
-        std::time_t tt = std::chrono::system_clock::to_time_t(now);
-        std::ostringstream ts;
-        ts << std::put_time(std::localtime(&tt), "%Y-%m-%d %H:%M:%S");
+    void write(LogLevel level, std::string_view message) override {
+        const auto now = std::chrono::system_clock::now();
+        std::string clipped;
+        if (message.size() > max_message_) {
+            clipped.assign(message.substr(0, max_message_ - kTruncated.size()));
+            clipped += kTruncated;
+            message = clipped;
+        }
+        std::size_t end = 0;
+        while ((end = queue_.try_push(level, now, message)) == 0) {
+            if (cfg_.overflow == LogOverflowPolicy::Drop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wake();
+            std::this_thread::yield();
+        }
+        if (const std::size_t done = written_.load(std::memory_order_relaxed); end > done && end - done >= high_water_) wake();
+    }
 
-        const char* p = level == LogLevel::Warn ? "WARN" : (level == LogLevel::Error ? "ERROR" : "INFO");
-        const std::string line = ts.str() + " [" + p + "] " + std::string(message) + "\n";
-        std::cout << line;
-        std::ofstream out(cfg_.file_path, std::ios::app);
-        out << line;
+    void flush() override {
+        const std::size_t target = queue_.enqueued();
+        wake();
+        while (written_.load(std::memory_order_acquire) < target) std::this_thread::sleep_for(std::chrono::microseconds(200));
     }
 
   private:
-    void rotate_if_needed() {
-        namespace fs = std::filesystem;
-        if (!fs::exists(cfg_.file_path)) return;
-        if (fs::file_size(cfg_.file_path) < cfg_.rotate_size_bytes) return;
+    // Rare (high water, flush, shutdown), so taking the mutex here costs nothing on the common path.
+    void wake() {
+        if (wake_pending_.exchange(true, std::memory_order_acq_rel)) return;
+        { const std::lock_guard<std::mutex> lock(wake_mutex_); }
+        wake_cv_.notify_one();
+    }
+
+    void run() {
+        for (;;) {
+            const bool stopping = stop_.load(std::memory_order_acquire);
+            wake_pending_.store(false, std::memory_order_release);
+            drain();
+            if (stopping) break;
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_for(lock, kWriterInterval, [this] { return wake_pending_.load(std::memory_order_acquire); });
+        }
+        drain();
+    }
+
+    void drain() {
+        std::size_t taken = 0;
+        while (const LogSlot* slot = queue_.front()) {
+            if (pending_.empty()) {
+                pending_level_ = slot->level;
+                pending_time_ = slot->time;
+            }
+            const bool more = slot->more;
+            if (more || !pending_.empty()) pending_.append(slot->text, slot->len);
+            else append_line(slot->level, slot->time, std::string_view(slot->text, slot->len));
+            queue_.pop();
+            ++taken;
+            if (!more && !pending_.empty()) {
+                append_line(pending_level_, pending_time_, pending_);
+                pending_.clear();
+            }
+        }
+        if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped > 0) {
+            append_line(LogLevel::Warn, std::chrono::system_clock::now(),
+                        "logger queue full, dropped " + std::to_string(dropped) + " messages");
+        }
+        if (!batch_.empty()) {
+            if (cfg_.console) {
+                std::fwrite(batch_.data(), 1, batch_.size(), stdout);
+                std::fflush(stdout);
+            }
+            write_file(batch_);
+            batch_.clear();
+        }
+        if (taken > 0) written_.fetch_add(taken, std::memory_order_release);
+    }
+
+    void append_line(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message) {
+        const std::time_t tt = std::chrono::system_clock::to_time_t(time);
+        if (tt != stamp_time_) {
+            std::tm tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &tt);
+#else
+            localtime_r(&tt, &tm);
+#endif
+            stamp_len_ = std::strftime(stamp_, sizeof(stamp_), "%Y-%m-%d %H:%M:%S", &tm);
+            stamp_time_ = tt;
+        }
+        batch_.append(stamp_, stamp_len_);
+        batch_ += " [";
+        batch_ += level_name(level);
+        batch_ += "] ";
+        batch_ += message;
+        batch_ += '\n';
+    }
+
+    void write_file(const std::string& data) {
+        if (!file_) return;
+        if (file_bytes_ >= cfg_.rotate_size_bytes) rotate();
+        if (!file_) return;
+        std::fwrite(data.data(), 1, data.size(), file_);
+        std::fflush(file_);
+        file_bytes_ += data.size();
+    }
 
+    void open_file() {
+        file_ = std::fopen(cfg_.file_path.c_str(), "ab");
+        if (!file_) return;
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(cfg_.file_path, ec);
+        file_bytes_ = ec ? 0 : static_cast<std::size_t>(size);
+    }
+
+    void rotate() {
+        namespace fs = std::filesystem;
+        std::fclose(file_);
+        file_ = nullptr;
+        std::error_code ec;
         for (int i = static_cast<int>(cfg_.rotate_count) - 1; i >= 1; --i) {
             const std::string from = cfg_.file_path + "." + std::to_string(i);
             const std::string to = cfg_.file_path + "." + std::to_string(i + 1);
-            if (fs::exists(from)) fs::rename(from, to);
+            if (fs::exists(from, ec)) fs::rename(from, to, ec);
         }
-        fs::rename(cfg_.file_path, cfg_.file_path + ".1");
+        fs::rename(cfg_.file_path, cfg_.file_path + ".1", ec);
+        open_file();
     }
 
     LoggingSection cfg_;
-    std::mutex mu_;
+    LogQueue queue_;
+    std::size_t high_water_; // queued slots that wake the writer early
+    std::size_t max_message_;
+    std::thread writer_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> wake_pending_{false};
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::size_t> written_{0}; // slots consumed
+
+    // Writer thread only.
+    std::FILE* file_{nullptr};
+    std::size_t file_bytes_{0};
+    std::string batch_;
+    std::string pending_; // a message spanning several slots, until its last one is published
+    LogLevel pending_level_{LogLevel::Info};
+    std::chrono::system_clock::time_point pending_time_{};
+    std::time_t stamp_time_{-1};
+    char stamp_[32]{};
+    std::size_t stamp_len_{0};
 };
 
 std::unique_ptr<Logger> g_logger;
@@ -63,4 +293,8 @@ void log(LogLevel level, std::string_view message) {
     g_logger->write(level, message);
 }
 
+void flush_log() {
+    if (g_logger) g_logger->flush();
+}
+
 } // namespace sonarlock::core
@@ -0,0 +1,150 @@
+#include "sonarlock/core/metrics_export.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace sonarlock::core {
+
+namespace {
+
+void append_value(std::string& out, double v) {
+    if (std::isnan(v)) { out += "NaN"; return; }
+    if (std::isinf(v)) { out += v > 0.0 ? "+Inf" : "-Inf"; return; }
+    std::array<char, 32> buf{};
+    const auto res = std::to_chars(buf.data(), buf.data() + buf.size(), v);
+    out.append(buf.data(), res.ptr);
+}
+
+void header(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP sonarlock_";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE sonarlock_";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+// One sample; label is `key="value"` or empty.
+void sample(std::string& out, const char* name, const char* label, double v) {
+    out += "sonarlock_";
+    out += name;
+    if (*label) {
+        out += '{';
+        out += label;
+        out += '}';
+    }
+    out += ' ';
+    append_value(out, v);
+    out += '\n';
+}
+
+void metric(std::string& out, const char* name, const char* type, const char* help, double v) {
+    header(out, name, type, help);
+    sample(out, name, "", v);
+}
+
+} // namespace
+
+void append_prometheus(std::string& out, const RuntimeMetrics& m) {
+    constexpr double kSec = 1e-6; // CallbackTiming is in microseconds
+    const auto count = [](std::uint64_t v) { return static_cast<double>(v); };
+    const auto& t = m.timing;
+
+    metric(out, "callbacks_total", "counter", "Audio callbacks processed.", count(m.callbacks));
+    metric(out, "frames_processed_total", "counter", "Audio frames processed.", count(m.frames_processed));
+    metric(out, "triggers_total", "counter", "Detector updates in the Triggered state.", count(m.triggered_count));
+    metric(out, "threshold_updates_total", "counter", "Online threshold adaptation steps.", count(m.threshold_updates));
+    metric(out, "detection_state", "gauge", "0 idle, 1 observing, 2 triggered, 3 cooldown.",
+           static_cast<double>(m.latest_event.state));
+    metric(out, "calibration_state", "gauge", "0 init, 1 warmup, 2 calibrating, 3 armed.",
+           static_cast<double>(m.latest_event.calibration));
+    metric(out, "score", "gauge", "Latest motion score.", m.latest_event.score);
+    metric(out, "confidence", "gauge", "Latest detection confidence.", m.latest_event.confidence);
+    metric(out, "trigger_threshold", "gauge", "Trigger threshold in use.", m.trigger_threshold);
+    metric(out, "release_threshold", "gauge", "Release threshold in use.", m.release_threshold);
+    metric(out, "relative_motion", "gauge", "Doppler energy relative to the baseline.", m.features.relative_motion);
+    metric(out, "baseband_energy", "gauge", "Baseband energy.", m.features.baseband_energy);
+    metric(out, "doppler_band_energy", "gauge", "Doppler band energy.", m.features.doppler_band_energy);
+    metric(out, "snr_estimate", "gauge", "Signal to noise estimate.", m.features.snr_estimate);
+    metric(out, "doppler_peak_hz", "gauge", "Signed Doppler peak of the latest STFT frame.", m.features.doppler_peak_hz);
+    metric(out, "input_peak_level", "gauge", "Input peak level of the latest buffer.", m.peak_level);
+    metric(out, "input_rms_level", "gauge", "Input RMS level of the latest buffer.", m.rms_level);
+    metric(out, "dominant_channel", "gauge", "Input channel driving detection.", count(m.dominant_channel));
+
+    header(out, "callback_compute_seconds", "summary", "Time spent in process() per callback.");
+    sample(out, "callback_compute_seconds", "quantile=\"0.5\"", t.compute_p50_us * kSec);
+    sample(out, "callback_compute_seconds", "quantile=\"0.99\"", t.compute_p99_us * kSec);
+    sample(out, "callback_compute_seconds", "quantile=\"1\"", t.compute_max_us * kSec);
+    sample(out, "callback_compute_seconds_sum", "", t.compute_mean_us * kSec * count(m.callbacks));
+    sample(out, "callback_compute_seconds_count", "", count(m.callbacks));
+    metric(out, "callback_deadline_misses_total", "counter", "Callbacks whose compute time exceeded the buffer duration.",
+           count(t.deadline_misses));
+    metric(out, "callback_period_seconds", "gauge", "Buffer duration.", t.period_us * kSec);
+    metric(out, "callback_min_headroom_seconds", "gauge", "Smallest buffer duration minus compute time.",
+           t.min_headroom_us * kSec);
+    metric(out, "callback_jitter_p99_seconds", "gauge", "99th percentile of callback start jitter.", t.jitter_p99_us * kSec);
+    header(out, "callback_stage_seconds", "gauge", "Mean time per callback in each process() stage.");
+    constexpr const char* kStages[kDspStages] = {"stage=\"mix\"", "stage=\"filter\"", "stage=\"features\"",
+                                                 "stage=\"detect\"", "stage=\"journal\""};
+    for (std::size_t s = 0; s < kDspStages; ++s) {
+        if (!std::isnan(t.stage_mean_us[s])) sample(out, "callback_stage_seconds", kStages[s], t.stage_mean_us[s] * kSec); // NaN: not timed
+    }
+}
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+Status MetricsExporter::start(const IDspPipeline& pipeline, const std::string& path, std::uint32_t interval_ms) {
+    stop();
+    if (path.empty() || interval_ms == 0) return Status::error(kErrInvalidArgument, "metrics export needs a path and an interval");
+    pipeline_ = &pipeline;
+    path_ = path;
+    tmp_path_ = path + ".tmp";
+    interval_ = std::chrono::milliseconds(interval_ms);
+    text_.reserve(8 * 1024);
+    if (!export_once()) return Status::error(kErrInvalidArgument, "cannot write metrics file: " + path);
+    stop_ = false;
+    thread_ = std::thread([this] { run(); });
+    return Status::success();
+}
+
+void MetricsExporter::stop() {
+    if (!thread_.joinable()) return;
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    export_once();
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, interval_, [this] { return stop_; })) {
+        lock.unlock();
+        export_once();
+        lock.lock();
+    }
+}
+
+bool MetricsExporter::export_once() {
+    text_.clear();
+    append_prometheus(text_, pipeline_->snapshot());
+    std::FILE* f = std::fopen(tmp_path_.c_str(), "wb");
+    if (!f) return false;
+    const bool written = std::fwrite(text_.data(), 1, text_.size(), f) == text_.size();
+    if (std::fclose(f) != 0 || !written) return false;
+    std::error_code ec;
+    std::filesystem::rename(tmp_path_, path_, ec);
+    if (ec) return false;
+    exports_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace sonarlock::core
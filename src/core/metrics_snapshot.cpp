@@ -0,0 +1,54 @@
+#include "sonarlock/core/metrics_snapshot.hpp"
+
+namespace sonarlock::core {
+
+MetricsSnapshot MetricsSnapshot::from(const RuntimeMetrics& m) {
+    MetricsSnapshot s{};
+    s.sample_rate_hz = m.sample_rate_hz;
+    s.frames_per_buffer = m.frames_per_buffer;
+    s.input_channels = m.input_channels;
+    s.dominant_channel = m.dominant_channel;
+    s.callbacks = m.callbacks;
+    s.frames_processed = m.frames_processed;
+    s.callback_allocations = m.callback_allocations;
+    s.triggered_count = m.triggered_count;
+    s.threshold_updates = m.threshold_updates;
+    s.peak_level = m.peak_level;
+    s.rms_level = m.rms_level;
+    s.dc_offset = m.dc_offset;
+    s.state = m.latest_event.state;
+    s.calibration = m.latest_event.calibration;
+    s.action = m.latest_action.type;
+    s.score = m.latest_event.score;
+    s.confidence = m.latest_event.confidence;
+    s.event_timestamp_sec = m.latest_event.timestamp_sec;
+    s.action_timestamp_sec = m.latest_action.timestamp_sec;
+    s.action_reason = m.latest_action.reason.data();
+    s.action_reason_size = m.latest_action.reason.size();
+    s.trigger_threshold = m.trigger_threshold;
+    s.release_threshold = m.release_threshold;
+    for (std::size_t i = 0; i < kFeatureFields.size(); ++i) s.features[i] = m.features.*kFeatureFields[i];
+    return s;
+}
+
+void MetricsSnapshot::apply_to(RuntimeMetrics& m) const {
+    m.sample_rate_hz = sample_rate_hz;
+    m.frames_per_buffer = frames_per_buffer;
+    m.input_channels = input_channels;
+    m.dominant_channel = dominant_channel;
+    m.callbacks = callbacks;
+    m.frames_processed = frames_processed;
+    m.callback_allocations = callback_allocations;
+    m.triggered_count = triggered_count;
+    m.threshold_updates = threshold_updates;
+    m.peak_level = peak_level;
+    m.rms_level = rms_level;
+    m.dc_offset = dc_offset;
+    m.latest_event = MotionEvent{state, calibration, score, confidence, event_timestamp_sec};
+    m.latest_action = ActionRequest{action, action_timestamp_sec, std::string_view(action_reason, action_reason_size)};
+    m.trigger_threshold = trigger_threshold;
+    m.release_threshold = release_threshold;
+    for (std::size_t i = 0; i < kFeatureFields.size(); ++i) m.features.*kFeatureFields[i] = features[i];
+}
+
+} // namespace sonarlock::core
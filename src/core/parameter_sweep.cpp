@@ -0,0 +1,130 @@
+#include "sonarlock/core/parameter_sweep.hpp"
+
+#include "sonarlock/core/calibration.hpp"
+#include "sonarlock/core/motion_detection.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace sonarlock::core {
+
+void FeatureRecorder::begin_session(const AudioConfig& config) {
+    frames_.clear();
+    input_channels_ = config.audio.input_channels;
+    baseline_alpha_ = config.dsp.baseline_alpha;
+    baseline_motion_alpha_ = config.dsp.baseline_motion_alpha;
+    const auto& a = config.audio;
+    if (a.duration_seconds > 0.0 && a.frames_per_buffer > 0) {
+        frames_.reserve(static_cast<std::size_t>(a.duration_seconds * a.sample_rate_hz) / a.frames_per_buffer + 2);
+    }
+}
+
+void FeatureRecorder::take(FeatureTrace& trace) {
+    trace.frames = take_frames();
+    trace.input_channels = input_channels_;
+    trace.baseline_alpha = baseline_alpha_;
+    trace.baseline_motion_alpha = baseline_motion_alpha_;
+}
+
+std::vector<DetectionSection> expand_grid(const DetectionSection& base, const SweepGrid& grid) {
+    const auto or_base = [](const auto& axis, auto value) {
+        using T = decltype(value);
+        return axis.empty() ? std::vector<T>{value} : std::vector<T>(axis.begin(), axis.end());
+    };
+    const auto trig = or_base(grid.trigger_threshold, base.trigger_threshold);
+    const auto rel = or_base(grid.release_threshold, base.release_threshold);
+    const auto deb = or_base(grid.debounce_ms, base.debounce_ms);
+    const auto cool = or_base(grid.cooldown_ms, base.cooldown_ms);
+
+    std::vector<DetectionSection> out;
+    out.reserve(trig.size() * rel.size() * deb.size() * cool.size());
+    for (const double t : trig) {
+        for (const double r : rel) {
+            if (r >= t) continue;
+            for (const auto d : deb) {
+                for (const auto c : cool) {
+                    DetectionSection p = base;
+                    p.trigger_threshold = t;
+                    p.release_threshold = r;
+                    p.debounce_ms = d;
+                    p.cooldown_ms = c;
+                    out.push_back(p);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+namespace {
+
+// Same per-callback sequence as BasicDspPipeline::process: the baseline rate follows the previous
+// detector state, calibration sees that state and may replace the thresholds for this update only,
+// then the detector runs.
+void evaluate(const FeatureTrace& t, const DetectionSection& point, const CalibrationSection& cal_cfg,
+              const DefaultMotionScorer& scorer, SweepResult& r, double& latency_sum) {
+    const bool has_motion = t.motion_start_sec >= 0.0;
+    const bool replay_baseline = t.input_channels == 1;
+    CalibrationController calibration(cal_cfg, point);
+    DetectionStateMachine fsm(point);
+    DetectionState last = DetectionState::Idle;
+    double baseline = 0.0;
+    bool detected = false;
+    for (std::size_t k = 0; k < t.frames.size(); ++k) {
+        const double ts = t.frames[k].timestamp_sec;
+        MotionFeatures f = t.frames[k].features;
+        if (replay_baseline) {
+            const bool motion_like = last == DetectionState::Observing || last == DetectionState::Triggered;
+            const double alpha = motion_like ? t.baseline_motion_alpha : t.baseline_alpha;
+            baseline = (1.0 - alpha) * baseline + alpha * f.doppler_band_energy;
+            f.baseline_energy = baseline;
+            f.relative_motion = std::max(0.0, f.doppler_band_energy - baseline);
+        }
+        DetectionSection det = point;
+        calibration.update(ts, f.relative_motion, det, last);
+        fsm.set_config(det);
+        const double score = scorer.score(f);
+        last = fsm.update(score, std::clamp(score, 0.0, 1.0), ts, calibration.state()).state;
+        if (last != DetectionState::Triggered) continue;
+        ++r.triggers;
+        if (has_motion && ts >= t.motion_start_sec && ts <= t.motion_end_sec) {
+            if (!detected) latency_sum += ts - t.motion_start_sec;
+            detected = true;
+        } else {
+            ++r.false_triggers;
+        }
+    }
+    if (has_motion) ++r.motion_traces;
+    if (detected) ++r.detected;
+}
+
+} // namespace
+
+std::vector<SweepResult> run_sweep(std::span<const FeatureTrace> traces, std::span<const DetectionSection> grid,
+                                   const CalibrationSection& calibration, std::size_t workers) {
+    const DefaultMotionScorer scorer;
+    std::vector<SweepResult> results(grid.size());
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < grid.size();
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            auto& r = results[i];
+            r.detection = grid[i];
+            double latency_sum = 0.0;
+            for (const auto& t : traces) evaluate(t, grid[i], calibration, scorer, r, latency_sum);
+            if (r.detected > 0) r.mean_latency_sec = latency_sum / static_cast<double>(r.detected);
+        }
+    };
+
+    if (workers == 0) workers = std::max(1U, std::thread::hardware_concurrency());
+    workers = std::min(workers, std::max<std::size_t>(grid.size(), 1));
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads) t.join();
+    return results;
+}
+
+} // namespace sonarlock::core
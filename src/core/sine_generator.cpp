@@ -1,43 +1,45 @@
 #include "sonarlock/core/sine_generator.hpp"
 
 #include <algorithm>
-#include <cmath>
+#include <array>
 
 namespace sonarlock::core {
 
-namespace {
-constexpr double kTwoPi = 6.28318530717958647692;
-}
-
 SineGenerator::SineGenerator(double sample_rate_hz, double frequency_hz, double fade_ms)
-    : sample_rate_hz_(sample_rate_hz), frequency_hz_(frequency_hz) {
-    fade_samples_ = static_cast<std::size_t>((fade_ms / 1000.0) * sample_rate_hz_);
+    : osc_(sample_rate_hz, frequency_hz, NcoMode::Recurrence) {
+    const auto fade_samples = static_cast<std::size_t>((fade_ms / 1000.0) * sample_rate_hz);
+    fade_ramp_.resize(fade_samples);
+    for (std::size_t k = 0; k < fade_samples; ++k) {
+        fade_ramp_[k] = static_cast<float>(static_cast<double>(k) / static_cast<double>(fade_samples));
+    }
 }
 
-void SineGenerator::set_frequency(double frequency_hz) { frequency_hz_ = frequency_hz; }
-
-void SineGenerator::reset() { phase_ = 0.0; }
-
-void SineGenerator::generate(std::vector<float>& out, std::size_t total_frames, std::size_t frame_offset) {
-    const double phase_inc = kTwoPi * frequency_hz_ / sample_rate_hz_;
-    for (std::size_t i = 0; i < out.size(); ++i) {
-        const std::size_t absolute_frame = frame_offset + i;
-        double env = 1.0;
-        if (fade_samples_ > 0) {
-            if (absolute_frame < fade_samples_) {
-                env = static_cast<double>(absolute_frame) / static_cast<double>(fade_samples_);
-            }
-            const std::size_t remaining = total_frames > absolute_frame ? (total_frames - absolute_frame) : 0;
-            if (remaining < fade_samples_) {
-                env = std::min(env, static_cast<double>(remaining) / static_cast<double>(fade_samples_));
-            }
-        }
-
-        out[i] = static_cast<float>(std::sin(phase_) * env);
-        phase_ += phase_inc;
-        if (phase_ >= kTwoPi) {
-            phase_ -= kTwoPi;
-        }
+void SineGenerator::set_frequency(double frequency_hz) { osc_.set_frequency(frequency_hz); }
+
+void SineGenerator::reset() { osc_.reset(); }
+
+void SineGenerator::generate(std::span<float> out, std::size_t total_frames, std::size_t frame_offset) {
+    std::array<double, kNcoCheckInterval> c{};
+    std::array<double, kNcoCheckInterval> s{};
+    for (std::size_t k = 0; k < out.size(); k += c.size()) {
+        const std::size_t m = std::min(c.size(), out.size() - k);
+        osc_.fill(std::span<double>(c.data(), m), std::span<double>(s.data(), m));
+        for (std::size_t j = 0; j < m; ++j) out[k + j] = static_cast<float>(s[j]);
+    }
+
+    // Envelope only touches the first and last fade_samples frames of the session.
+    const std::size_t fade = fade_ramp_.size();
+    if (fade == 0) return;
+    const std::size_t end = frame_offset + out.size();
+    const std::size_t fade_out_start = total_frames >= fade ? total_frames - fade + 1 : 0;
+    const auto fade_out = [&](std::size_t a) { return a < total_frames ? fade_ramp_[total_frames - a] : 0.0F; };
+
+    for (std::size_t a = frame_offset; a < std::min(end, fade); ++a) {
+        const float env = a >= fade_out_start ? std::min(fade_ramp_[a], fade_out(a)) : fade_ramp_[a];
+        out[a - frame_offset] *= env;
+    }
+    for (std::size_t a = std::max({frame_offset, fade, fade_out_start}); a < end; ++a) {
+        out[a - frame_offset] *= fade_out(a);
     }
 }
 
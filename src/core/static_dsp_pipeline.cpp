@@ -0,0 +1,34 @@
+#include "sonarlock/core/static_dsp_pipeline.hpp"
+
+namespace sonarlock::core {
+
+template class StaticDspPipeline<kStaticDspDefault>;
+template class StaticDspPipeline<kStaticDspButterworth>;
+template class StaticDspPipeline<kStaticDspDecimated>;
+
+namespace {
+template <StaticDspSpec... Specs>
+struct StaticPresets {
+    static bool any(const AudioConfig& config) { return (matches(Specs, config) || ...); }
+    // First match wins.
+    static std::unique_ptr<IDspPipeline> make(const AudioConfig& config) {
+        std::unique_ptr<IDspPipeline> out;
+        ((out = !out && matches(Specs, config) ? std::make_unique<StaticDspPipeline<Specs>>() : std::move(out)), ...);
+        return out;
+    }
+};
+
+using Presets = StaticPresets<kStaticDspDefault, kStaticDspButterworth, kStaticDspDecimated>;
+} // namespace
+
+bool has_static_dsp_pipeline(const AudioConfig& config) { return Presets::any(config); }
+
+std::unique_ptr<IDspPipeline> make_dsp_pipeline(const AudioConfig& config) {
+    // Opt-in: the static pipeline agrees with Basic to ~1e-8, not bit for bit, and times fewer stages.
+    if (config.dsp.pipeline != DspPipelineKind::Basic) {
+        if (auto p = Presets::make(config)) return p;
+    }
+    return std::make_unique<BasicDspPipeline>();
+}
+
+} // namespace sonarlock::core
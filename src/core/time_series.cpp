@@ -0,0 +1,202 @@
+#include "sonarlock/core/time_series.hpp"
+
+#include "sonarlock/core/feature_trace.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace sonarlock::core {
+
+namespace {
+constexpr std::array<char, 8> kMagic{'S', 'L', 'S', 'E', 'R', 'I', 'E', 'S'};
+constexpr std::uint32_t kByteOrder = 0x01020304U;
+constexpr std::size_t kFlushBytes = 64 * 1024;
+constexpr std::size_t kFeatureCount = kFeatureFields.size();
+
+static_assert(std::is_trivially_copyable_v<SeriesRow>);
+static_assert(sizeof(double) + (4 + kFeatureCount) * sizeof(float) + 4 == kSeriesRecordBytes);
+
+const char* state_label(DetectionState s) {
+    switch (s) {
+    case DetectionState::Idle: return "IDLE";
+    case DetectionState::Observing: return "OBSERVING";
+    case DetectionState::Triggered: return "TRIGGERED";
+    case DetectionState::Cooldown: return "COOLDOWN";
+    }
+    return "?";
+}
+
+// Appends a separator and the value (9 significant digits, enough to round-trip a float). A line has
+// room for every field at full width, so to_chars cannot run out of space.
+char* put(char* p, char* end, double v) {
+    *p++ = ',';
+    const auto res = std::to_chars(p, end, v, std::chars_format::general, 9);
+    return res.ec == std::errc{} ? res.ptr : p;
+}
+
+char* put(char* p, char* end, int v) {
+    *p++ = ',';
+    const auto res = std::to_chars(p, end, v);
+    return res.ec == std::errc{} ? res.ptr : p;
+}
+
+template <typename T>
+std::byte* pack(std::byte* at, T v) {
+    std::memcpy(at, &v, sizeof(v));
+    return at + sizeof(v);
+}
+
+template <typename T>
+const std::byte* unpack(const std::byte* at, T& v) {
+    std::memcpy(&v, at, sizeof(v));
+    return at + sizeof(v);
+}
+} // namespace
+
+SeriesFormat series_format_for(const std::string& path) {
+    constexpr std::string_view ext = ".csv";
+    return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0 ? SeriesFormat::Csv
+                                                                                                     : SeriesFormat::Binary;
+}
+
+SeriesWriter::~SeriesWriter() { close(); }
+
+Status SeriesWriter::open(const std::string& path, SeriesFormat format, const AudioConfig& config, bool block_when_full,
+                          std::size_t ring_rows) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return Status::error(kErrInvalidArgument, "cannot create series file: " + path);
+    format_ = format;
+    block_when_full_ = block_when_full;
+    buffer_.clear();
+    buffer_.reserve(kFlushBytes + 1024);
+    if (format_ == SeriesFormat::Csv) {
+        buffer_ = "timestamp_sec,state,calibration,action,score,confidence,trigger_th,release_th";
+        for (std::size_t c = 1; c < kTraceColumns; ++c) {
+            buffer_ += ',';
+            buffer_ += trace_column_name(c);
+        }
+        buffer_ += '\n';
+    } else {
+        std::array<std::byte, kSeriesHeaderBytes> header{};
+        std::byte* at = header.data();
+        std::memcpy(at, kMagic.data(), kMagic.size());
+        at = pack(at + kMagic.size(), kByteOrder);
+        at = pack(at, kSeriesVersion);
+        at = pack(at, static_cast<std::uint32_t>(kSeriesRecordBytes));
+        at = pack(at, std::uint32_t{0});
+        at = pack(at, config.audio.sample_rate_hz);
+        pack(at, static_cast<std::uint64_t>(config.audio.frames_per_buffer));
+        buffer_.append(reinterpret_cast<const char*>(header.data()), header.size());
+    }
+    ring_.reserve(ring_rows);
+    rows_written_ = 0;
+    ring_.start(std::min<std::size_t>(256, ring_.capacity()), std::chrono::milliseconds(5),
+                [this](std::span<const SeriesRow> rows) { return write_rows(rows); });
+    return Status::success();
+}
+
+void SeriesWriter::push(const SeriesRow& row) {
+    const std::span<const SeriesRow> one(&row, 1);
+    if (block_when_full_) ring_.push_wait(one);
+    else ring_.push(one);
+}
+
+bool SeriesWriter::write_rows(std::span<const SeriesRow> rows) {
+    for (const auto& row : rows) encode(row);
+    rows_written_ += rows.size();
+    return buffer_.size() < kFlushBytes || flush_buffer();
+}
+
+void SeriesWriter::encode(const SeriesRow& row) {
+    if (format_ == SeriesFormat::Binary) {
+        std::array<std::byte, kSeriesRecordBytes> rec{};
+        std::byte* at = pack(rec.data(), row.timestamp_sec);
+        for (const double v : {row.score, row.confidence, row.trigger_threshold, row.release_threshold}) at = pack(at, static_cast<float>(v));
+        for (const auto field : kFeatureFields) at = pack(at, static_cast<float>(row.features.*field));
+        at = pack(at, static_cast<std::uint8_t>(row.state));
+        at = pack(at, static_cast<std::uint8_t>(row.calibration));
+        pack(at, static_cast<std::uint8_t>(row.action));
+        buffer_.append(reinterpret_cast<const char*>(rec.data()), rec.size());
+        return;
+    }
+    std::array<char, 512> line;
+    char* const end = line.data() + line.size();
+    const auto ts = std::to_chars(line.data(), end, row.timestamp_sec); // shortest exact form
+    char* p = ts.ec == std::errc{} ? ts.ptr : line.data();
+    *p++ = ',';
+    for (const char* s = state_label(row.state); *s; ++s) *p++ = *s;
+    p = put(p, end, static_cast<int>(row.calibration));
+    p = put(p, end, static_cast<int>(row.action));
+    for (const double v : {row.score, row.confidence, row.trigger_threshold, row.release_threshold}) p = put(p, end, v);
+    for (const auto field : kFeatureFields) p = put(p, end, row.features.*field);
+    *p++ = '\n';
+    buffer_.append(line.data(), p);
+}
+
+bool SeriesWriter::flush_buffer() {
+    const bool ok = std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size();
+    buffer_.clear();
+    return ok;
+}
+
+Status SeriesWriter::close() {
+    if (!file_) return Status::success();
+    ring_.stop();
+    bool ok = !ring_.failed() && flush_buffer();
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok ? Status::success() : Status::error(kErrStreamFailure, "series file incomplete: write failed");
+}
+
+void SeriesTap::process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) {
+    inner_.process(input, output, frame_offset);
+    const auto m = inner_.latest();
+    writer_.push(SeriesRow{m.latest_event.timestamp_sec, m.latest_event.state, m.latest_event.calibration,
+                           m.latest_action.type, m.latest_event.score, m.latest_event.confidence, m.trigger_threshold,
+                           m.release_threshold, m.features});
+}
+
+Status SeriesReader::open(const std::string& path) {
+    rows_ = 0;
+    if (auto st = file_.open(path); !st.ok()) return st;
+    const auto bytes = file_.bytes();
+    if (bytes.size() < kSeriesHeaderBytes || std::memcmp(bytes.data(), kMagic.data(), kMagic.size()) != 0) {
+        return Status::error(kErrInputFile, "not a series file: " + path);
+    }
+    std::uint32_t order = 0, version = 0, record = 0, reserved = 0;
+    const std::byte* at = unpack(bytes.data() + kMagic.size(), order);
+    at = unpack(unpack(unpack(at, version), record), reserved);
+    unpack(at, sample_rate_hz_);
+    if (order != kByteOrder || version != kSeriesVersion || record != kSeriesRecordBytes) {
+        return Status::error(kErrInputFile, "unsupported series version or byte order: " + path);
+    }
+    rows_ = (bytes.size() - kSeriesHeaderBytes) / kSeriesRecordBytes;
+    return Status::success();
+}
+
+SeriesRow SeriesReader::row(std::size_t index) const {
+    SeriesRow r;
+    const std::byte* at = unpack(file_.bytes().data() + kSeriesHeaderBytes + index * kSeriesRecordBytes, r.timestamp_sec);
+    for (double* v : {&r.score, &r.confidence, &r.trigger_threshold, &r.release_threshold}) {
+        float f = 0.0F;
+        at = unpack(at, f);
+        *v = f;
+    }
+    for (const auto field : kFeatureFields) {
+        float f = 0.0F;
+        at = unpack(at, f);
+        r.features.*field = f;
+    }
+    std::uint8_t state = 0, calibration = 0, action = 0;
+    unpack(unpack(unpack(at, state), calibration), action);
+    r.state = static_cast<DetectionState>(state);
+    r.calibration = static_cast<CalibrationState>(calibration);
+    r.action = static_cast<ActionType>(action);
+    return r;
+}
+
+} // namespace sonarlock::core
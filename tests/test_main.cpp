@@ -1,14 +1,47 @@
 #include "sonarlock/app/cli.hpp"
 #include "sonarlock/audio/fake_audio_backend.hpp"
+#include "sonarlock/audio/file_audio_backend.hpp"
+#include "sonarlock/audio/scenario_synth.hpp"
 #include "sonarlock/core/action_policy.hpp"
+#include "sonarlock/core/alloc_audit.hpp"
+#include "sonarlock/core/async_dsp_runner.hpp"
+#include "sonarlock/core/batch_engine.hpp"
+#include "sonarlock/core/biquad.hpp"
 #include "sonarlock/core/calibration.hpp"
+#include "sonarlock/core/callback_timing.hpp"
+#include "sonarlock/core/capture_recorder.hpp"
+#include "sonarlock/core/dsp_kernels.hpp"
 #include "sonarlock/core/dsp_pipeline.hpp"
+#include "sonarlock/core/doppler_spectrogram.hpp"
 #include "sonarlock/core/dsp_primitives.hpp"
+#include "sonarlock/core/event_journal.hpp"
+#include "sonarlock/core/feature_trace.hpp"
+#include "sonarlock/core/fft.hpp"
+#include "sonarlock/core/logger.hpp"
+#include "sonarlock/core/metrics_export.hpp"
+#include "sonarlock/core/metrics_snapshot.hpp"
+#include "sonarlock/core/parameter_sweep.hpp"
+#include "sonarlock/core/seqlock.hpp"
+#include "sonarlock/core/sine_generator.hpp"
+#include "sonarlock/core/static_dsp_pipeline.hpp"
+#include "sonarlock/core/time_series.hpp"
 #include "sonarlock/platform/action_executor.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cmath>
+#include <complex>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -77,6 +110,12 @@ bool test_cli_parsing_phase3_flags() {
     return st.ok() && c.config.audio.duration_seconds == 0.0 && c.config.daemon_mode && c.config.actions.manual_disable;
 }
 
+bool test_cli_parsing_decoupled_flags() {
+    sonarlock::app::CommandLine c;
+    auto st = sonarlock::app::parse_args({"run","--backend","fake","--decoupled-dsp","--ring-blocks","8"}, c);
+    return st.ok() && c.config.audio.decoupled_dsp && c.config.audio.ring_blocks == 8;
+}
+
 bool test_integration_human_triggers_static_not() {
     sonarlock::core::AudioConfig cfg;
     cfg.audio.duration_seconds = 3.0;
@@ -95,6 +134,1224 @@ bool test_integration_human_triggers_static_not() {
     return mh.frames_processed > 0 && ms.frames_processed > 0;
 }
 
+bool near_rel(double a, double b, double tol) { return std::abs(a - b) <= tol * std::max({1.0, std::abs(a), std::abs(b)}); }
+
+bool test_simd_kernels_match_scalar() {
+    namespace k = sonarlock::core::kernels;
+    std::vector<float> x(1027);
+    std::vector<double> c(x.size()), s(x.size());
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        x[n] = static_cast<float>(0.3 * std::sin(0.37 * n) - 0.1 * std::cos(0.011 * n));
+        c[n] = std::cos(0.5 * n);
+        s[n] = std::sin(0.5 * n);
+    }
+    auto run = [&](k::SimdLevel level, std::vector<double>& mag) {
+        k::set_active_level(level);
+        std::vector<double> i(x.size()), q(x.size());
+        mag.assign(x.size(), 0.0);
+        const auto st = k::input_stats(x);
+        k::mix(x, c, s, i, q);
+        const double e = k::magnitude(i, q, mag);
+        const double d = k::doppler_energy(mag, x, 0.05F, 0.05);
+        return std::vector<double>{st.peak, st.sum, st.sum_sq, e, d};
+    };
+    std::vector<double> mag_ref, mag_simd;
+    const auto ref = run(k::SimdLevel::Scalar, mag_ref);
+    const auto got = run(k::detected_level(), mag_simd);
+    k::set_active_level(k::detected_level());
+    for (std::size_t n = 0; n < ref.size(); ++n) if (!near_rel(ref[n], got[n], k::kReductionTolerance)) return false;
+    return mag_ref == mag_simd;
+}
+
+bool test_block_pipeline_matches_scalar_kernels() {
+    namespace k = sonarlock::core::kernels;
+    sonarlock::core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 1.0;
+    cfg.audio.frames_per_buffer = 253;
+    auto run = [&](k::SimdLevel level) {
+        k::set_active_level(level);
+        sonarlock::audio::FakeAudioBackend b(sonarlock::core::FakeScenario::Human, 7);
+        sonarlock::core::BasicDspPipeline p;
+        sonarlock::core::RuntimeMetrics m;
+        b.run_session(cfg, p, m, [] { return false; });
+        return m;
+    };
+    const auto ref = run(k::SimdLevel::Scalar);
+    const auto got = run(k::detected_level());
+    return near_rel(ref.features.baseband_energy, got.features.baseband_energy, k::kReductionTolerance) &&
+           near_rel(ref.features.doppler_band_energy, got.features.doppler_band_energy, k::kReductionTolerance) &&
+           near_rel(ref.features.phase_velocity, got.features.phase_velocity, k::kReductionTolerance) &&
+           near_rel(ref.rms_level, got.rms_level, 1e-6) && ref.peak_level == got.peak_level;
+}
+
+bool test_nco_batch_modes_bounded() {
+    using sonarlock::core::Nco;
+    using sonarlock::core::NcoMode;
+    Nco ref(48000.0, 19000.0, NcoMode::Direct);
+    Nco rec(48000.0, 19000.0, NcoMode::Recurrence);
+    Nco lut(48000.0, 19000.0, NcoMode::Lut);
+    std::vector<double> rc(1000), rs(1000), c(1000), s(1000);
+    for (int block = 0; block < 2880; ++block) {
+        ref.fill(rc, rs);
+        for (auto* nco : {&rec, &lut}) {
+            nco->fill(c, s);
+            const double bound = Nco::phase_error_bound(nco->mode());
+            for (std::size_t k = 0; k < c.size(); k += 97) {
+                const double err = std::abs(std::atan2(s[k] * rc[k] - c[k] * rs[k], c[k] * rc[k] + s[k] * rs[k]));
+                if (err > bound) return false;
+            }
+        }
+    }
+    const auto [c0, s0] = Nco(48000.0, 12000.0).next();
+    return rec.max_phase_error() <= Nco::phase_error_bound(NcoMode::Recurrence) &&
+           lut.max_phase_error() <= Nco::phase_error_bound(NcoMode::Lut) && lut.max_phase_error() > 0.0 && c0 == 1.0 &&
+           s0 == 0.0;
+}
+
+bool test_sine_generator_span_matches_reference() {
+    constexpr double kTwoPi = 6.28318530717958647692;
+    for (std::size_t total : {std::size_t{5000}, std::size_t{1500}}) {
+        sonarlock::core::SineGenerator gen(48000.0, 19000.0);
+        std::vector<float> out(total + 40);
+        for (std::size_t off = 0; off < out.size(); off += 37) {
+            const std::size_t n = std::min<std::size_t>(37, out.size() - off);
+            gen.generate(std::span<float>(out.data() + off, n), total, off);
+        }
+        for (std::size_t a = 0; a < out.size(); ++a) {
+            const double remaining = total > a ? static_cast<double>(total - a) : 0.0;
+            const double env = std::min({1.0, static_cast<double>(a) / 960.0, remaining / 960.0});
+            if (std::abs(out[a] - std::sin(kTwoPi * 19000.0 / 48000.0 * a) * env) > 1e-6) return false;
+        }
+    }
+    return true;
+}
+
+bool test_callback_path_allocation_free() {
+    sonarlock::core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 10.0;
+    cfg.calibration.warmup_seconds = 1.0;
+    cfg.calibration.calibrate_seconds = 2.0;
+    cfg.actions.mode = sonarlock::core::ActionMode::Lock;
+    sonarlock::audio::FakeAudioBackend b(sonarlock::core::FakeScenario::Human, 7);
+    sonarlock::core::BasicDspPipeline p;
+    sonarlock::core::RuntimeMetrics m;
+    if (!b.run_session(cfg, p, m, [] { return false; }).ok()) return false;
+
+    // A callback longer than frames_per_buffer runs as buffer-sized updates, without growing scratch.
+    const auto oversize = [&cfg](sonarlock::core::IDspPipeline& whole, sonarlock::core::IDspPipeline& split) {
+        sonarlock::audio::ScenarioSynth synth(cfg, sonarlock::core::FakeScenario::Human, 7, cfg.audio.duration_seconds);
+        const std::size_t fpb = cfg.audio.frames_per_buffer;
+        std::vector<float> in(4 * fpb - 24), out_whole(in.size()), out_split(in.size());
+        synth.render(0, in);
+        whole.begin_session(cfg);
+        split.begin_session(cfg);
+        const auto allocs = sonarlock::core::alloc_audit::callback_allocations();
+        {
+            const sonarlock::core::alloc_audit::CallbackScope scope;
+            whole.process(in, out_whole, 0);
+        }
+        for (std::size_t off = 0; off < in.size(); off += fpb) {
+            const std::size_t n = std::min(fpb, in.size() - off);
+            split.process(std::span<const float>(in).subspan(off, n), std::span<float>(out_split).subspan(off, n), off);
+        }
+        const auto a = whole.metrics();
+        const auto c = split.metrics();
+        return sonarlock::core::alloc_audit::callback_allocations() == allocs && a.callbacks == 4 && c.callbacks == 4 &&
+               a.frames_processed == c.frames_processed && a.features.relative_motion == c.features.relative_motion &&
+               a.latest_event.timestamp_sec == c.latest_event.timestamp_sec && out_whole == out_split;
+    };
+    sonarlock::core::BasicDspPipeline whole, split;
+    sonarlock::core::StaticDspPipeline<sonarlock::core::kStaticDspDefault> fixed_whole, fixed_split;
+    if (!oversize(whole, split) || !oversize(fixed_whole, fixed_split)) return false;
+
+    if (!sonarlock::core::alloc_audit::enabled()) return m.callback_allocations == 0;
+    // Sanity-check the hook itself, then require a clean session.
+    const auto before = sonarlock::core::alloc_audit::callback_allocations();
+    {
+        const sonarlock::core::alloc_audit::CallbackScope scope;
+        void* (*volatile allocate)(std::size_t) = &::operator new;
+        ::operator delete(allocate(16));
+    }
+    return m.callback_allocations == 0 && sonarlock::core::alloc_audit::callback_allocations() == before + 1;
+}
+
+// Records the frame offset of every block the runner hands to the pipeline.
+class OffsetRecorder final : public sonarlock::core::ForwardingPipeline {
+  public:
+    using ForwardingPipeline::ForwardingPipeline;
+    void process(std::span<const float> input, std::span<float> output, std::size_t frame_offset) override {
+        offsets_[std::min(count_.load(), offsets_.size() - 1)] = frame_offset;
+        ForwardingPipeline::process(input, output, frame_offset);
+        count_.fetch_add(1, std::memory_order_release);
+    }
+    [[nodiscard]] std::size_t count() const { return count_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t offset(std::size_t i) const { return offsets_[i]; }
+
+  private:
+    std::array<std::size_t, 16> offsets_{};
+    std::atomic<std::size_t> count_{0};
+};
+
+bool test_async_runner_ring_accounting() {
+    sonarlock::core::AudioConfig cfg;
+    cfg.audio.ring_blocks = 4;
+    sonarlock::core::BasicDspPipeline p;
+    p.begin_session(cfg);
+    OffsetRecorder rec(p);
+    sonarlock::core::AsyncDspRunner runner(rec, cfg);
+    const std::size_t fpb = cfg.audio.frames_per_buffer;
+    std::vector<float> in(fpb, 0.1F), out(fpb, 1.0F);
+    for (int i = 0; i < 6; ++i) runner.exchange(in, out); // worker not started: ring fills, TX starves
+    runner.start();
+    // The worker stalls on the full TX ring after three blocks; two more callbacks land after the drop.
+    for (int spin = 0; spin < 2000 && rec.count() < 3; ++spin) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const bool out_starved = out[0] == 0.0F;
+    runner.exchange(in, out);
+    runner.exchange(in, out);
+    runner.stop();
+    auto m = p.metrics();
+    runner.fill_metrics(m);
+    // Blocks queued before the drop keep their offsets; the ones after it skip the dropped frames.
+    bool ok = rec.count() == 6;
+    for (std::size_t i = 0; ok && i < 6; ++i) ok = rec.offset(i) == (i < 4 ? i : i + 2) * fpb;
+    return ok && m.ring_overruns == 2 && m.ring_underruns == 6 && m.rx_ring_high_water == 4 * fpb &&
+           m.frames_processed == 6 * fpb && out_starved && out[0] == 0.0F &&
+           m.latest_event.timestamp_sec == static_cast<double>(8 * fpb) / cfg.audio.sample_rate_hz;
+}
+
+bool test_decoupled_dsp_offline_backends() {
+    using namespace sonarlock;
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 4.0;
+    cfg.audio.frames_per_buffer = 300; // the last callback is a partial block
+    cfg.calibration.enabled = false;
+    cfg.scenario = core::FakeScenario::Human;
+    const auto same = [](const core::RuntimeMetrics& a, const core::RuntimeMetrics& b) {
+        return a.frames_processed == b.frames_processed && a.callbacks == b.callbacks && a.triggered_count == b.triggered_count &&
+               a.features.relative_motion == b.features.relative_motion && a.latest_event.score == b.latest_event.score &&
+               a.latest_event.timestamp_sec == b.latest_event.timestamp_sec && b.ring_overruns == 0 && b.ring_underruns == 0;
+    };
+    const auto run = [](core::IAudioBackend& backend, core::AudioConfig c, bool decoupled) {
+        c.audio.decoupled_dsp = decoupled;
+        core::BasicDspPipeline p;
+        core::RuntimeMetrics m;
+        if (!backend.run_session(c, p, m, [] { return false; }).ok()) m.callbacks = 0;
+        return m;
+    };
+    audio::FakeAudioBackend fake(cfg.scenario, cfg.seed);
+    const auto inline_fake = run(fake, cfg, false);
+    bool ok = inline_fake.triggered_count > 0 && same(inline_fake, run(fake, cfg, true));
+
+    const std::string raw = (std::filesystem::temp_directory_path() / "sonarlock_test_decoupled.f32").string();
+    const auto frames = static_cast<std::size_t>(cfg.audio.duration_seconds * cfg.audio.sample_rate_hz);
+    std::vector<float> samples(frames);
+    audio::ScenarioSynth(cfg, cfg.scenario, cfg.seed, cfg.audio.duration_seconds).render(0, samples);
+    std::ofstream(raw, std::ios::binary).write(reinterpret_cast<const char*>(samples.data()),
+                                                static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    cfg.audio.input_path = raw;
+    audio::FileAudioBackend file;
+    const auto inline_file = run(file, cfg, false);
+    ok = ok && inline_file.callbacks > 0 && same(inline_file, run(file, cfg, true));
+    std::filesystem::remove(raw);
+    return ok;
+}
+
+bool test_spsc_ring_wraps() {
+    sonarlock::core::SpscRing<int> ring(5);
+    std::vector<int> a{1, 2, 3}, b(3);
+    bool ok = ring.capacity() == 8;
+    for (int round = 0; round < 10; ++round) {
+        ok = ok && ring.push(a) && ring.pop(b) && b == a;
+        a = {a[0] + 3, a[1] + 3, a[2] + 3};
+    }
+    return ok && ring.push(a) && ring.push(a) && !ring.push(a) && ring.size() == 6;
+}
+
+bool test_event_journal_pod_ring() {
+    using namespace sonarlock::core;
+    EventJournal j(3);
+    j.push(JournalRecord{0.0, 0.0F, 0.0F, JournalEventKind::SessionStart});
+    for (int i = 1; i <= 4; ++i) {
+        j.push(JournalRecord{0.5 * i, 0.25F, 0.125F, JournalEventKind::Update, DetectionState::Observing,
+                             CalibrationState::Armed, ActionType::None});
+    }
+    return j.size() == 3 && j.dump_json_array(1) == "[{\"t\":2,\"state\":1,\"cal\":3,\"score\":0.25,\"rel\":0.125,\"action\":0}]" &&
+           j.dump_json_array(10).rfind("[{\"t\":1,", 0) == 0 && EventJournal(2).dump_json_array(5) == "[]";
+}
+
+bool test_async_logger_rotation() {
+    namespace fs = std::filesystem;
+    sonarlock::core::LoggingSection cfg;
+    cfg.file_path = (fs::temp_directory_path() / "sonarlock_test_rotation.log").string();
+    cfg.rotate_size_bytes = 256;
+    cfg.rotate_count = 2;
+    cfg.overflow = sonarlock::core::LogOverflowPolicy::Block;
+    cfg.queue_capacity = 8;
+    cfg.console = false;
+    for (const auto& p : {cfg.file_path, cfg.file_path + ".1", cfg.file_path + ".2"}) fs::remove(p);
+    std::string long_line(1500, 'x'); // spans four slots
+    for (std::size_t k = 0; k < long_line.size(); k += 100) long_line[k] = static_cast<char>('a' + k / 100);
+    {
+        auto logger = sonarlock::core::make_console_file_logger(cfg);
+        for (int i = 0; i < 40; ++i) {
+            logger->write(sonarlock::core::LogLevel::Info, "rotation line " + std::to_string(i));
+            if (i % 10 == 9) logger->flush();
+        }
+        logger->write(sonarlock::core::LogLevel::Warn, long_line);
+        logger->write(sonarlock::core::LogLevel::Info, std::string(5000, 'y')); // more than the whole queue
+    }
+    const auto read = [](const std::string& path) {
+        std::ifstream in(path);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+    const std::string all = read(cfg.file_path + ".2") + read(cfg.file_path + ".1") + read(cfg.file_path);
+    const bool ok = fs::exists(cfg.file_path + ".1") && fs::exists(cfg.file_path + ".2") &&
+                    all.find("[INFO] rotation line 39\n") != std::string::npos &&
+                    all.find("[WARN] " + long_line + "\n") != std::string::npos &&
+                    all.find(std::string(3840 - 15, 'y') + " ...[truncated]\n") != std::string::npos;
+    for (const auto& p : {cfg.file_path, cfg.file_path + ".1", cfg.file_path + ".2"}) fs::remove(p);
+    return ok;
+}
+
+bool test_streaming_median_mad_bound() {
+    using sonarlock::core::StreamingMedianMad;
+    std::mt19937 rng(11);
+    std::lognormal_distribution<double> dist(std::log(0.004), 0.8);
+    for (int trial = 0; trial < 3; ++trial) {
+        StreamingMedianMad est;
+        std::vector<double> xs;
+        for (int i = 0; i < 20000; ++i) {
+            const double x = (i % 7 == 0 && trial == 1) ? 0.0 : dist(rng) * (trial == 2 ? 1000.0 : 1.0);
+            xs.push_back(x);
+            est.add(x);
+        }
+        std::sort(xs.begin(), xs.end());
+        const double median = xs[xs.size() / 2];
+        for (auto& x : xs) x = std::abs(x - median);
+        std::sort(xs.begin(), xs.end());
+        const double mad = xs[xs.size() / 2];
+        const auto [m, d] = est.median_mad();
+        const double e = StreamingMedianMad::relative_error();
+        if (std::abs(m - median) > e * median || std::abs(d - mad) > e * (2.0 * median + mad)) return false;
+    }
+    return StreamingMedianMad{}.median_mad().first == 0.0;
+}
+
+bool test_online_threshold_adaptation() {
+    using namespace sonarlock::core;
+    CalibrationSection c;
+    c.warmup_seconds = 0.2;
+    c.calibrate_seconds = 0.4;
+    c.min_threshold = 0.01;
+    c.adapt = true;
+    c.adapt_interval_seconds = 0.5;
+    c.adapt_window_seconds = 2.0;
+    c.adapt_max_step = 0.005;
+    CalibrationController cc(c, DetectionSection{});
+    DetectionSection d;
+    double t = 0.0;
+    for (int i = 0; i < 100; ++i, t += 0.01) cc.update(t, 0.02 + 0.001 * (i % 3), d);
+    const double calibrated = d.trigger_threshold;
+    if (cc.state() != CalibrationState::Armed || cc.threshold_updates() != 0) return false;
+
+    // Room noise drifts up: thresholds follow in bounded steps, never leaving Armed.
+    double prev = calibrated;
+    for (int i = 0; i < 3000; ++i, t += 0.01) {
+        d = DetectionSection{};
+        cc.update(t, 0.05 + 0.003 * (i % 3), d);
+        if (cc.state() != CalibrationState::Armed || std::abs(d.trigger_threshold - prev) > c.adapt_max_step + 1e-12) return false;
+        if (d.release_threshold >= d.trigger_threshold) return false;
+        prev = d.trigger_threshold;
+    }
+    const std::uint64_t updates = cc.threshold_updates();
+    if (updates == 0 || updates > 3000 / 50 + 1 || d.trigger_threshold < calibrated + 0.03) return false;
+
+    // Samples taken while the detector is not Idle are ignored.
+    const double settled = d.trigger_threshold;
+    for (int i = 0; i < 1000; ++i, t += 0.01) cc.update(t, 5.0, d, DetectionState::Triggered);
+    return std::abs(d.trigger_threshold - settled) < 0.005;
+}
+
+bool test_cic_decimator_front_end() {
+    using sonarlock::core::CicDecimator;
+    CicDecimator dc(32);
+    std::vector<double> in(300, 0.25), out(in.size());
+    std::size_t consumed = 0, produced = 0;
+    for (const std::size_t len : {100U, 37U, 1U, 256U, 300U, 170U}) {
+        const std::size_t expect_first = dc.next_output_offset();
+        const std::size_t got = dc.process_block(std::span<const double>(in.data(), len), out);
+        if (got > 0 && (consumed + expect_first + 1) % 32 != 0) return false;
+        consumed += len;
+        produced += got;
+    }
+    if (produced != consumed / 32 || std::abs(out[0] - 0.25) > 1e-6) return false;
+
+    // Impulse alignment: whatever the input phase, the response is centred group_delay() input samples
+    // before the input sample that emits it. The first output that sees the impulse is the one its
+    // window ends in.
+    for (const std::size_t at : {31U, 40U, 47U, 64U, 100U}) {
+        CicDecimator d(32);
+        std::vector<double> imp(32 * 16, 0.0), resp(imp.size());
+        imp[at] = 1.0;
+        const std::size_t n = d.process_block(imp, resp);
+        double sum = 0.0, moment = 0.0;
+        for (std::size_t k = 0; k < n; ++k) {
+            sum += resp[k];
+            moment += static_cast<double>(k) * resp[k];
+        }
+        const double emitted_at = moment / sum * 32.0 + 31.0;
+        const auto first = static_cast<std::size_t>(std::find_if(resp.begin(), resp.end(), [](double v) { return v != 0.0; }) - resp.begin());
+        if (std::abs(emitted_at - static_cast<double>(at) - CicDecimator::group_delay(32)) > 1e-6 || first != at / 32) return false;
+    }
+
+    // The mixer's 2 * f0 image must not alias into the baseband.
+    CicDecimator img(32);
+    std::vector<double> tone(48000);
+    for (std::size_t k = 0; k < tone.size(); ++k) tone[k] = std::cos(6.28318530717958647692 * 38000.0 * k / 48000.0);
+    const std::size_t n = img.process_block(tone, tone);
+    double peak = 0.0;
+    for (std::size_t k = 8; k < n; ++k) peak = std::max(peak, std::abs(tone[k]));
+    if (n != 1500 || peak > 1e-4) return false;
+
+    sonarlock::core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 2.0;
+    cfg.calibration.enabled = false;
+    sonarlock::core::RuntimeMetrics full, dec;
+    for (auto* m : {&full, &dec}) {
+        cfg.dsp.decimation = m == &dec ? 32 : 1;
+        sonarlock::audio::FakeAudioBackend b(sonarlock::core::FakeScenario::Human, 7);
+        sonarlock::core::BasicDspPipeline p;
+        if (!b.run_session(cfg, p, *m, []{ return false; }).ok()) return false;
+    }
+    return dec.frames_processed == full.frames_processed && dec.latest_event.timestamp_sec == full.latest_event.timestamp_sec &&
+           near_rel(dec.features.baseband_energy, full.features.baseband_energy, 0.02);
+}
+
+bool test_phase_step_matches_atan2() {
+    namespace k = sonarlock::core::kernels;
+    for (int n = -2000; n <= 2000; ++n) {
+        const double a = 3.14159265358979323846 * n / 2000.0;
+        for (const double r : {1e-6, 0.3, 7.0}) {
+            if (std::abs(k::fast_atan2(r * std::sin(a), r * std::cos(a)) - std::atan2(r * std::sin(a), r * std::cos(a))) >
+                k::kAtan2MaxError) return false;
+        }
+    }
+
+    std::vector<double> i(1031), q(i.size());
+    for (std::size_t n = 0; n < i.size(); ++n) {
+        i[n] = 0.2 * std::cos(0.9 * n + 0.3 * std::sin(0.01 * n));
+        q[n] = 0.2 * std::sin(0.9 * n + 0.3 * std::sin(0.01 * n));
+    }
+    auto run = [&](k::SimdLevel level) {
+        k::set_active_level(level);
+        std::vector<double> out(i.size());
+        sonarlock::core::PhaseDifferentiator d;
+        for (std::size_t at = 0; at < i.size();) { // uneven blocks exercise the carried sample
+            const std::size_t len = std::min<std::size_t>(i.size() - at, 1 + at % 97);
+            d.process_block(std::span<const double>(i).subspan(at, len), std::span<const double>(q).subspan(at, len),
+                            std::span<double>(out).subspan(at, len));
+            at += len;
+        }
+        return out;
+    };
+    const auto ref = run(k::SimdLevel::Scalar);
+    const auto got = run(k::detected_level());
+    k::set_active_level(k::detected_level());
+    if (ref != got || ref[0] != 0.0) return false;
+
+    sonarlock::core::PhaseTracker tracker;
+    double last = tracker.unwrap(i[0], q[0]);
+    for (std::size_t n = 1; n < i.size(); ++n) {
+        const double u = tracker.unwrap(i[n], q[n]);
+        if (std::abs((u - last) - ref[n]) > 2.0 * k::kAtan2MaxError) return false;
+        last = u;
+    }
+    return true;
+}
+
+bool test_biquad_cascade_designs() {
+    using namespace sonarlock::core;
+    // One-pole designs reproduce the IirLowPass band chain; lanes stay independent.
+    BiquadCascade<2, 2> band;
+    band.set_lane(0, {design_one_pole_highpass(48000.0, 20.0), design_one_pole_lowpass(48000.0, 200.0)});
+    band.set_lane(1, {BiquadCoeffs{}, BiquadCoeffs{}});
+    IirLowPass dc(48000.0, 20.0), lp(48000.0, 200.0);
+    std::vector<double> x(4000), y(x.size()), passthru(x.size());
+    for (std::size_t n = 0; n < x.size(); ++n) x[n] = std::sin(0.01 * n) + 0.3 * std::cos(0.4 * n) + 0.2;
+    band.process_block({std::span<const double>(x).first(1500), std::span<const double>(x).first(1500)},
+                       {std::span<double>(y).first(1500), std::span<double>(passthru).first(1500)});
+    band.process_block({std::span<const double>(x).subspan(1500), std::span<const double>(x).subspan(1500)},
+                       {std::span<double>(y).subspan(1500), std::span<double>(passthru).subspan(1500)});
+    if (passthru != x) return false;
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        if (std::abs(y[n] - lp.process(x[n] - dc.process(x[n]))) > 1e-12) return false;
+    }
+
+    // Butterworth sections: -3 dB at the corner and far steeper roll-off than one pole.
+    auto gain = [](const BiquadCoeffs& c, double f) {
+        BiquadCascade<1, 1> filt;
+        filt.set_all_lanes({c});
+        std::vector<double> s(48000);
+        for (std::size_t n = 0; n < s.size(); ++n) s[n] = std::sin(6.28318530717958647692 * f * n / 48000.0);
+        filt.process_block({s}, {s});
+        double peak = 0.0;
+        for (std::size_t n = s.size() / 2; n < s.size(); ++n) peak = std::max(peak, std::abs(s[n]));
+        return peak;
+    };
+    const auto lp2 = design_lowpass(48000.0, 500.0);
+    const auto hp2 = design_highpass(48000.0, 500.0);
+    const auto bp2 = design_bandpass(48000.0, 500.0, 2.0);
+    return std::abs(gain(lp2, 500.0) - std::sqrt(0.5)) < 0.01 && std::abs(gain(hp2, 500.0) - std::sqrt(0.5)) < 0.01 &&
+           gain(lp2, 5000.0) < 0.011 && gain(design_one_pole_lowpass(48000.0, 500.0), 5000.0) > 0.09 &&
+           std::abs(gain(bp2, 500.0) - 1.0) < 0.01 && gain(bp2, 50.0) < 0.06;
+}
+
+bool test_fft_and_doppler_spectrogram() {
+    using namespace sonarlock::core;
+    constexpr double kTwoPi = 6.28318530717958647692;
+    for (const std::size_t n : {2U, 8U, 64U, 128U}) {
+        std::vector<std::complex<double>> x(n), ref(n);
+        for (std::size_t k = 0; k < n; ++k) x[k] = {std::sin(0.7 * k) + 0.1 * k, std::cos(1.3 * k)};
+        for (std::size_t f = 0; f < n; ++f) {
+            for (std::size_t k = 0; k < n; ++k) ref[f] += x[k] * std::polar(1.0, -kTwoPi * f * k / n);
+        }
+        const FftPlan plan(n);
+        auto y = x;
+        plan.forward(y);
+        for (std::size_t f = 0; f < n; ++f) if (std::abs(y[f] - ref[f]) > 1e-9) return false;
+        plan.inverse(y);
+        for (std::size_t k = 0; k < n; ++k) if (std::abs(y[k] / static_cast<double>(n) - x[k]) > 1e-12) return false;
+    }
+
+    // A reflector approaching at +120 Hz and one receding at -60 Hz, sampled at 1.5 kHz.
+    AudioConfig cfg;
+    auto run = [&](double fd) {
+        DopplerSpectrogram sg;
+        sg.configure(1500.0, cfg);
+        std::vector<double> i(3000), q(3000);
+        for (std::size_t k = 0; k < i.size(); ++k) {
+            i[k] = 0.1 * std::cos(kTwoPi * fd * k / 1500.0);
+            q[k] = 0.1 * std::sin(kTwoPi * fd * k / 1500.0);
+        }
+        const std::size_t frames = sg.push(i, q);
+        MotionFeatures f;
+        sg.fill(f);
+        const double bin = sg.frame_rate_hz() / cfg.dsp.stft_size;
+        const bool ok = frames == (i.size() / 2 - cfg.dsp.stft_size) / cfg.dsp.stft_hop + 1 && sg.spectrum().size() == cfg.dsp.stft_size &&
+                        std::abs(f.doppler_peak_hz - fd) <= bin && (fd > 0.0) == (f.radial_velocity_mps > 0.0) &&
+                        (fd > 0.0 ? f.approach_energy > 100.0 * f.recede_energy : f.recede_energy > 100.0 * f.approach_energy);
+        return ok;
+    };
+    return run(120.0) && run(-60.0);
+}
+
+bool test_multichannel_fusion_matches_mono() {
+    using namespace sonarlock::core;
+    constexpr double kTwoPi = 6.28318530717958647692;
+    // Channels 0 and 2 see a static room; channel 1 also hears a reflector at +120 Hz in the second half.
+    AudioConfig mono;
+    mono.audio.duration_seconds = 2.0;
+    AudioConfig multi = mono;
+    multi.audio.input_channels = 3;
+    BasicDspPipeline p0, p1, p;
+    p0.begin_session(mono);
+    p1.begin_session(mono);
+    p.begin_session(multi);
+
+    const std::size_t frames = mono.audio.frames_per_buffer;
+    std::vector<float> c0(frames), c1(frames), inter(3 * frames), out(frames);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> noise(-0.01F, 0.01F);
+    bool ok = true;
+    for (std::size_t off = 0; off < 96000; off += frames) {
+        for (std::size_t k = 0; k < frames; ++k) {
+            const double t = static_cast<double>(off + k) / 48000.0;
+            c0[k] = static_cast<float>(0.25 * std::sin(kTwoPi * 19000.0 * t)) + noise(rng);
+            c1[k] = static_cast<float>(0.2 * std::sin(kTwoPi * 19000.0 * t + 1.0) +
+                                       (t > 1.0 ? 0.3 * std::sin(kTwoPi * 19120.0 * t) : 0.0)) + noise(rng);
+            inter[3 * k] = c0[k];
+            inter[3 * k + 1] = c1[k];
+            inter[3 * k + 2] = c0[k];
+        }
+        p0.process(c0, out, off);
+        p1.process(c1, out, off);
+        p.process(inter, out, off);
+        const auto m0 = p0.metrics().features;
+        const auto m1 = p1.metrics().features;
+        const auto m = p.metrics();
+        const auto& ref = m.dominant_channel == 1 ? m1 : m0;
+        ok = ok && std::abs(m.features.relative_motion - std::max(m0.relative_motion, m1.relative_motion)) < 1e-9 &&
+             std::abs(m.features.doppler_band_energy - ref.doppler_band_energy) < 1e-9 &&
+             std::abs(m.features.phase_velocity - ref.phase_velocity) < 1e-6 * (1.0 + ref.phase_velocity);
+    }
+    const auto m = p.metrics();
+    return ok && m.input_channels == 3 && m.dominant_channel == 1 && m.frames_processed == 96000 &&
+           m.features.relative_motion > 0.0;
+}
+
+bool test_batch_engine_matches_sequential() {
+    using namespace sonarlock;
+    std::vector<core::AudioConfig> jobs;
+    for (std::uint32_t k = 0; k < 7; ++k) {
+        core::AudioConfig cfg;
+        cfg.audio.duration_seconds = 2.0;
+        cfg.scenario = static_cast<core::FakeScenario>(k % 4);
+        cfg.seed = 11 + k;
+        cfg.audio.input_channels = 1 + k % 2;
+        cfg.logging.journal_capacity = 16;
+        jobs.push_back(cfg);
+    }
+    auto backends = [](const core::AudioConfig& cfg) { return std::make_unique<audio::FakeAudioBackend>(cfg.scenario, cfg.seed); };
+    auto same = [](const core::BatchResult& r, const core::RuntimeMetrics& m, const std::vector<core::JournalRecord>& j) {
+        bool ok = r.status.ok() && r.metrics.frames_processed == m.frames_processed && r.metrics.callbacks == m.callbacks &&
+                  r.metrics.features.relative_motion == m.features.relative_motion &&
+                  r.metrics.features.phase_velocity == m.features.phase_velocity &&
+                  r.metrics.features.doppler_peak_hz == m.features.doppler_peak_hz && r.metrics.rms_level == m.rms_level &&
+                  r.metrics.latest_event.score == m.latest_event.score && r.metrics.triggered_count == m.triggered_count &&
+                  r.metrics.dominant_channel == m.dominant_channel && r.journal.size() == j.size();
+        for (std::size_t i = 0; ok && i < j.size(); ++i) {
+            ok = r.journal[i].timestamp_sec == j[i].timestamp_sec && r.journal[i].score == j[i].score &&
+                 r.journal[i].state == j[i].state && r.journal[i].kind == j[i].kind;
+        }
+        return ok;
+    };
+
+    core::BatchEngine engine(backends, 3);
+    const auto results = engine.run(jobs);
+    const auto again = engine.run(jobs); // reused worker pipelines must not carry state over
+    bool ok = results.size() == jobs.size() && engine.workers() == 3;
+    for (std::size_t i = 0; ok && i < jobs.size(); ++i) {
+        core::BasicDspPipeline p;
+        core::RuntimeMetrics m;
+        std::vector<core::JournalRecord> j;
+        ok = backends(jobs[i])->run_session(jobs[i], p, m, [] { return false; }).ok();
+        p.journal()->copy_to(j);
+        ok = ok && !j.empty() && same(results[i], m, j) && same(again[i], m, j);
+    }
+    return ok;
+}
+
+bool test_batch_engine_cancel() {
+    using namespace sonarlock;
+    std::vector<core::AudioConfig> jobs(5);
+    for (auto& cfg : jobs) cfg.audio.duration_seconds = 1.0;
+    core::BatchEngine* engine_ptr = nullptr;
+    std::atomic<int> started{0};
+    // One worker runs jobs in order; the second job cancels the batch as it starts.
+    core::BatchEngine engine(
+        [&](const core::AudioConfig& cfg) {
+            if (started.fetch_add(1) == 1) engine_ptr->cancel();
+            return std::make_unique<audio::FakeAudioBackend>(cfg.scenario, cfg.seed);
+        },
+        1);
+    engine_ptr = &engine;
+    const auto results = engine.run(jobs);
+    bool ok = results.size() == jobs.size() && started.load() == 2 && results[0].status.ok() &&
+              results[0].metrics.frames_processed > 0;
+    for (std::size_t i = 2; ok && i < jobs.size(); ++i) {
+        ok = results[i].status.code == core::kErrCancelled && results[i].metrics.frames_processed == 0;
+    }
+
+    // A cancel() before run() is kept for that run, then cleared.
+    engine.cancel();
+    const auto skipped = engine.run(jobs);
+    ok = ok && std::all_of(skipped.begin(), skipped.end(), [](const core::BatchResult& r) { return r.status.code == core::kErrCancelled; });
+    started = 2;
+    const auto rerun = engine.run(jobs);
+    return ok && started.load() == 7 &&
+           std::all_of(rerun.begin(), rerun.end(), [](const core::BatchResult& r) { return r.status.ok(); });
+}
+
+bool test_file_backend_matches_live() {
+    using namespace sonarlock;
+    constexpr double kTwoPi = 6.28318530717958647692;
+    // 3 s at 44.1 kHz with a +120 Hz reflector from 2 s; channel 1 is quieter.
+    const std::size_t frames = 3 * 44100;
+    std::vector<float> samples(2 * frames);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> noise(-0.01F, 0.01F);
+    for (std::size_t k = 0; k < frames; ++k) {
+        const double t = static_cast<double>(k) / 44100.0;
+        const double s = 0.25 * std::sin(kTwoPi * 19000.0 * t) + (t > 2.0 ? 0.3 * std::sin(kTwoPi * 19120.0 * t) : 0.0);
+        samples[2 * k] = static_cast<float>(s) + noise(rng);
+        samples[2 * k + 1] = static_cast<float>(0.5 * s) + noise(rng);
+    }
+
+    auto put = [](std::string& b, std::uint32_t v, int n) { for (int i = 0; i < n; ++i) b += static_cast<char>((v >> (8 * i)) & 0xFFU); };
+    // format 1 = PCM, 3 = float; returns what the backend should decode.
+    auto write_wav = [&](const std::string& path, std::uint16_t format, std::uint16_t bits, std::size_t channels) {
+        std::string data;
+        std::vector<float> decoded;
+        for (std::size_t k = 0; k < frames; ++k) {
+            for (std::size_t c = 0; c < channels; ++c) {
+                const float x = samples[2 * k + c];
+                if (format == 3) {
+                    put(data, std::bit_cast<std::uint32_t>(x), 4);
+                    decoded.push_back(x);
+                } else {
+                    const double scale = bits == 16 ? 32768.0 : 8388608.0;
+                    const auto q = static_cast<std::int32_t>(std::lround(x * scale));
+                    put(data, static_cast<std::uint32_t>(q), bits / 8);
+                    decoded.push_back(static_cast<float>(q) * static_cast<float>(1.0 / scale));
+                }
+            }
+        }
+        std::string b = "RIFF";
+        put(b, static_cast<std::uint32_t>(36 + data.size()), 4);
+        b += "WAVEfmt ";
+        put(b, 16, 4);
+        put(b, format, 2);
+        put(b, static_cast<std::uint32_t>(channels), 2);
+        put(b, 44100, 4);
+        put(b, static_cast<std::uint32_t>(44100 * channels * bits / 8), 4);
+        put(b, static_cast<std::uint32_t>(channels * bits / 8), 2);
+        put(b, bits, 2);
+        b += "data";
+        put(b, static_cast<std::uint32_t>(data.size()), 4);
+        std::ofstream(path, std::ios::binary) << b << data;
+        return decoded;
+    };
+
+    auto check = [&](const std::string& path, const std::vector<float>& decoded, std::size_t channels) {
+        core::AudioConfig cfg;
+        cfg.audio.input_path = path;
+        cfg.audio.input_channels = channels; // only used for raw files
+        cfg.audio.sample_rate_hz = 44100.0;
+        cfg.calibration.enabled = false; // detect within the short clip
+        core::BasicDspPipeline fp;
+        core::RuntimeMetrics fm;
+        audio::FileAudioBackend file;
+        if (!file.run_session(cfg, fp, fm, [] { return false; }).ok()) return false;
+
+        // The same samples, delivered live-style in frames_per_buffer blocks.
+        core::AudioConfig live = cfg;
+        live.audio.duration_seconds = static_cast<double>(frames) / 44100.0;
+        core::BasicDspPipeline lp;
+        lp.begin_session(live);
+        std::vector<float> out(cfg.audio.frames_per_buffer);
+        for (std::size_t off = 0; off < frames; off += cfg.audio.frames_per_buffer) {
+            const std::size_t n = std::min(cfg.audio.frames_per_buffer, frames - off);
+            lp.process(std::span<const float>(decoded).subspan(off * channels, n * channels), std::span<float>(out).first(n), off);
+        }
+        const auto lm = lp.metrics();
+        return fm.frames_processed == frames && fm.sample_rate_hz == 44100.0 && fm.input_channels == channels &&
+               fm.realtime_factor > 1.0 && fm.triggered_count == lm.triggered_count && fm.triggered_count > 0 &&
+               fm.features.relative_motion == lm.features.relative_motion && fm.latest_event.score == lm.latest_event.score &&
+               fm.latest_event.state == lm.latest_event.state;
+    };
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string f32 = (dir / "sonarlock_test_f32.wav").string();
+    const std::string p16 = (dir / "sonarlock_test_p16.wav").string();
+    const std::string p24 = (dir / "sonarlock_test_p24.wav").string();
+    const std::string raw = (dir / "sonarlock_test.f32").string();
+    bool ok = check(f32, write_wav(f32, 3, 32, 1), 1) && check(p16, write_wav(p16, 1, 16, 2), 2) &&
+              check(p24, write_wav(p24, 1, 24, 2), 2);
+    std::ofstream(raw, std::ios::binary).write(reinterpret_cast<const char*>(samples.data()),
+                                                static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    ok = ok && check(raw, samples, 2);
+
+    core::AudioConfig missing;
+    missing.audio.input_path = (dir / "sonarlock_no_such_file.wav").string();
+    core::BasicDspPipeline p;
+    core::RuntimeMetrics m;
+    ok = ok && audio::FileAudioBackend().run_session(missing, p, m, [] { return false; }).code == core::kErrInputFile;
+    for (const auto& f : {f32, p16, p24, raw}) std::filesystem::remove(f);
+    return ok;
+}
+
+bool test_capture_recorder_roundtrip() {
+    using namespace sonarlock;
+    const auto dir = std::filesystem::temp_directory_path();
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 2.0;
+    cfg.audio.input_channels = 2;
+    cfg.audio.record_path = (dir / "sonarlock_capture.wav").string();
+    cfg.audio.record_tx = true;
+    cfg.audio.record_ring_blocks = 1024; // holds the whole session: nothing may drop
+    cfg.scenario = core::FakeScenario::Human;
+    core::BasicDspPipeline live;
+    core::RuntimeMetrics lm;
+    bool ok = audio::FakeAudioBackend().run_session(cfg, live, lm, [] { return false; }).ok() &&
+              lm.recorded_frames == 96000 && lm.record_dropped_blocks == 0 && lm.callback_allocations == 0;
+
+    // Replaying the capture reproduces the live session exactly.
+    core::AudioConfig replay;
+    replay.audio.input_path = cfg.audio.record_path;
+    core::BasicDspPipeline p;
+    core::RuntimeMetrics rm;
+    ok = ok && audio::FileAudioBackend().run_session(replay, p, rm, [] { return false; }).ok() &&
+         rm.frames_processed == lm.frames_processed && rm.input_channels == 2 &&
+         rm.features.relative_motion == lm.features.relative_motion && rm.latest_event.score == lm.latest_event.score;
+    const auto tx_path = dir / "sonarlock_capture.tx.wav";
+    ok = ok && std::filesystem::file_size(tx_path) == 4096 + 96000 * sizeof(float) &&
+         std::filesystem::file_size(cfg.audio.record_path) == 4096 + 2 * 96000 * sizeof(float);
+
+    // A ring that cannot keep up drops whole blocks and says so.
+    core::CaptureRecorder rec;
+    const std::string small = (dir / "sonarlock_capture_small.wav").string();
+    ok = ok && rec.open(small, 48000.0, 1, 256, 2).ok();
+    std::vector<float> block(256, 0.5F);
+    for (int i = 0; i < 400; ++i) rec.push(block);
+    const std::uint64_t dropped_before = rec.dropped_blocks();
+    rec.push(std::vector<float>(8192, 0.5F)); // larger than the whole ring
+    ok = ok && rec.dropped_blocks() == dropped_before + 1 && rec.close().ok() &&
+         rec.frames_written() + 256 * dropped_before == 400 * 256;
+    for (const auto& f : {std::filesystem::path(cfg.audio.record_path), tx_path, std::filesystem::path(small)}) {
+        std::filesystem::remove(f);
+    }
+    return ok;
+}
+
+bool test_parameter_sweep_matches_live() {
+    using namespace sonarlock;
+    core::AudioConfig base;
+    base.audio.duration_seconds = 12.0;
+    const core::FakeScenario scenarios[] = {core::FakeScenario::Static, core::FakeScenario::Human};
+
+    // One pass serves every point: the sweep replays the baseline, which follows the detector state.
+    std::vector<core::FeatureTrace> traces;
+    for (const auto s : scenarios) {
+        core::AudioConfig cfg = base;
+        cfg.scenario = s;
+        core::BasicDspPipeline p;
+        core::FeatureRecorder rec;
+        core::FeatureTap tap(p, rec);
+        core::RuntimeMetrics m;
+        audio::FakeAudioBackend backend(s, cfg.seed);
+        if (!backend.run_session(cfg, tap, m, [] { return false; }).ok()) return false;
+        const auto [start, end] = audio::FakeAudioBackend::motion_window(s, cfg.audio.duration_seconds);
+        core::FeatureTrace trace{"t", {}, start, end};
+        rec.take(trace);
+        if (trace.frames.size() != m.callbacks || trace.baseline_motion_alpha != cfg.dsp.baseline_motion_alpha) return false;
+        traces.push_back(std::move(trace));
+    }
+
+    core::SweepGrid grid;
+    grid.trigger_threshold = {0.3, 0.52, 0.99};
+    grid.debounce_ms = {0, 300};
+    auto points = core::expand_grid(base.detection, grid);
+    bool ok = points.size() == 4; // 0.3 < release 0.38 is skipped
+    // Low thresholds keep the detector Observing/Triggered, where the baseline runs at the motion rate.
+    core::DetectionSection eager = base.detection;
+    eager.trigger_threshold = 0.1;
+    eager.release_threshold = 0.05;
+    eager.debounce_ms = 0;
+    eager.cooldown_ms = 0;
+    points.push_back(eager);
+    for (const bool adapt : {false, true}) {
+        core::CalibrationSection cal = base.calibration;
+        cal.adapt = adapt;
+        cal.adapt_interval_seconds = 1.0;
+        const auto results = core::run_sweep(traces, points, cal, 2);
+        for (std::size_t i = 0; ok && i < points.size(); ++i) {
+            std::uint64_t live = 0;
+            for (const auto s : scenarios) {
+                core::AudioConfig cfg = base;
+                cfg.scenario = s;
+                cfg.calibration = cal;
+                cfg.detection = points[i];
+                core::BasicDspPipeline p;
+                core::RuntimeMetrics m;
+                ok = ok && audio::FakeAudioBackend(s, cfg.seed).run_session(cfg, p, m, [] { return false; }).ok();
+                live += m.triggered_count;
+            }
+            ok = ok && results[i].triggers == live && results[i].motion_traces == 1;
+        }
+        // Without adaptation the configured thresholds hold: defaults catch only the human, 0.99 never fires.
+        if (!adapt) {
+            ok = ok && results[1].triggers > 0 && results[1].false_triggers == 0 && results[1].detected == 1 &&
+                 results[1].mean_latency_sec >= 0.3 && results[2].triggers == 0 && results[2].mean_latency_sec < 0.0;
+        }
+    }
+
+    app::CommandLine c;
+    ok = ok && app::parse_args({"analyze", "--sweep-trigger-th", "0.4:0.6:0.1", "--sweep-debounce-ms", "100,250"}, c).ok() &&
+         c.sweep && c.sweep_grid.trigger_threshold.size() == 3 && c.sweep_grid.debounce_ms == std::vector<std::uint32_t>{100, 250};
+    app::CommandLine r;
+    ok = ok && !app::parse_args({"run", "--sweep"}, r).ok();
+    return ok;
+}
+
+bool test_feature_trace_replay() {
+    using namespace sonarlock;
+    const auto path = (std::filesystem::temp_directory_path() / "sonarlock_test.sltrace").string();
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 12.0;
+    cfg.scenario = core::FakeScenario::Human;
+
+    core::BasicDspPipeline p;
+    core::FeatureTraceWriter writer;
+    core::FeatureTap tap(p, writer);
+    core::FeatureRecorder live;
+    core::FeatureTap live_tap(tap, live);
+    core::RuntimeMetrics m;
+    bool ok = writer.open(path, cfg).ok() &&
+              audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(cfg, live_tap, m, [] { return false; }).ok() &&
+              writer.close().ok() && writer.dropped_rows() == 0 && m.triggered_count > 0;
+    const auto frames = live.take_frames();
+
+    core::FeatureTraceReader trace;
+    ok = ok && trace.open(path).ok() && trace.rows() == m.callbacks && frames.size() == m.callbacks &&
+         trace.header().rows == m.callbacks && trace.blocks().size() > 1 &&
+         std::string(trace.header().column_names[6].data()) == "relative_motion";
+    std::size_t row = 0;
+    for (const auto& b : trace.blocks()) {
+        for (std::size_t r = 0; ok && r < b.rows; ++r, ++row) {
+            const auto& f = frames[row];
+            ok = b.column(0)[r] == f.timestamp_sec && b.column(1)[r] == f.features.baseband_energy &&
+                 b.column(6)[r] == f.features.relative_motion && b.column(11)[r] == f.features.recede_energy;
+        }
+    }
+
+    // Header config alone reproduces the live detections; a changed threshold matches a live run with it.
+    core::AudioConfig from_header;
+    from_header.dsp.lp_cutoff_hz = 1.0;
+    from_header.dsp.baseline_alpha = 0.5;
+    from_header.dsp.stft_size = 8;
+    trace.header().apply_to(from_header);
+    ok = ok && from_header.dsp.lp_cutoff_hz == cfg.dsp.lp_cutoff_hz && from_header.dsp.baseline_alpha == cfg.dsp.baseline_alpha &&
+         from_header.dsp.stft_size == cfg.dsp.stft_size && from_header.dsp.doppler_band_high_hz == cfg.dsp.doppler_band_high_hz;
+    const auto same = core::replay_trace(trace, from_header);
+    ok = ok && same.metrics.triggered_count == m.triggered_count && same.actions > 0 &&
+         same.metrics.latest_event.state == m.latest_event.state && same.metrics.latest_event.score == m.latest_event.score;
+    core::AudioConfig strict = cfg;
+    strict.detection.debounce_ms = 900;
+    core::BasicDspPipeline p2;
+    core::RuntimeMetrics m2;
+    ok = ok && audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(strict, p2, m2, [] { return false; }).ok() &&
+         core::replay_trace(trace, strict).metrics.triggered_count == m2.triggered_count;
+
+    // A file cut mid-block still reads every complete block.
+    const auto full = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, full - 100);
+    core::FeatureTraceReader cut;
+    ok = ok && cut.open(path).ok() && cut.rows() == m.callbacks - trace.blocks().back().rows;
+    std::filesystem::remove(path);
+    return ok;
+}
+
+bool test_callback_timing() {
+    using namespace sonarlock;
+    // Bucket edges are contiguous and every value lands in a bucket whose range holds it.
+    bool ok = core::LatencyHistogram::bucket(15) == 15 && core::LatencyHistogram::bucket(~std::uint64_t{0}) < core::LatencyHistogram::kBuckets;
+    for (std::size_t i = 1; ok && i < 900; ++i) ok = core::LatencyHistogram::bucket_upper(i) == core::LatencyHistogram::bucket_upper(i - 1) + (i < 32 ? 1 : (std::uint64_t{1} << (i / 16 - 1)));
+    for (std::uint64_t v : {0ULL, 17ULL, 1000ULL, 123456ULL, 98765432ULL}) {
+        const auto b = core::LatencyHistogram::bucket(v);
+        ok = ok && core::LatencyHistogram::bucket_upper(b) >= v && (b == 0 || core::LatencyHistogram::bucket_upper(b - 1) < v);
+    }
+
+    core::LatencyHistogram h;
+    for (std::uint64_t v = 1; v <= 10000; ++v) h.record(v * 100);
+    const auto within = [](double got, double want) { return got >= want && got <= want * (1.0 + 1.0 / 16.0); };
+    ok = ok && h.count() == 10000 && h.max_ns() == 1000000 && std::abs(h.mean_ns() - 500050.0) < 1e-6 &&
+         within(static_cast<double>(h.quantile_ns(0.5)), 500000.0) && within(static_cast<double>(h.quantile_ns(0.99)), 990000.0) &&
+         h.quantile_ns(1.0) == 1000000;
+    h.reset();
+    ok = ok && h.count() == 0 && h.quantile_ns(0.99) == 0;
+
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 3.0;
+    core::BasicDspPipeline p;
+    core::RuntimeMetrics m;
+    ok = ok && audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(cfg, p, m, [] { return false; }).ok();
+    const auto& t = m.timing;
+    double stages = 0.0;
+    for (const double s : t.stage_mean_us) stages += s;
+    const double period_us = 1e6 * static_cast<double>(cfg.audio.frames_per_buffer) / cfg.audio.sample_rate_hz;
+    ok = ok && std::abs(t.period_us - period_us) < 1e-3 && t.compute_mean_us > 0.0 && t.compute_p50_us <= t.compute_p99_us &&
+         t.compute_p99_us <= t.compute_max_us && std::abs(stages - t.compute_mean_us) < 1e-6 * std::max(1.0, t.compute_mean_us) &&
+         t.min_headroom_us <= period_us - t.compute_max_us + 1e-3 && (t.deadline_misses > 0) == (t.min_headroom_us < 0.0);
+
+    // A new session starts from empty histograms.
+    cfg.audio.duration_seconds = 0.5;
+    core::RuntimeMetrics m2;
+    ok = ok && audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(cfg, p, m2, [] { return false; }).ok() &&
+         m2.callbacks < m.callbacks && m2.timing.compute_max_us <= m.timing.compute_max_us * 100.0;
+    return ok;
+}
+
+bool test_metrics_snapshot_concurrent() {
+    using namespace sonarlock;
+    // Every field the writer sets is derived from one counter, so a torn read shows up as a mismatch.
+    core::Seqlock<core::MetricsSnapshot> lock;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        core::RuntimeMetrics m;
+        for (std::uint64_t i = 1; i <= 200000; ++i) {
+            m.callbacks = i;
+            m.frames_processed = i * 256;
+            m.triggered_count = i;
+            m.features.relative_motion = static_cast<double>(i);
+            m.features.recede_energy = static_cast<double>(i);
+            lock.store(core::MetricsSnapshot::from(m));
+        }
+        done.store(true);
+    });
+    bool ok = true;
+    std::uint64_t reads = 0, last = 0;
+    while (!done.load() || reads == 0) {
+        core::RuntimeMetrics m;
+        lock.load().apply_to(m);
+        const double c = static_cast<double>(m.callbacks);
+        ok = ok && m.callbacks >= last && m.frames_processed == m.callbacks * 256 && m.triggered_count == m.callbacks &&
+             m.features.relative_motion == c && m.features.recede_energy == c;
+        last = m.callbacks;
+        ++reads;
+    }
+    writer.join();
+    ok = ok && lock.load().callbacks == 200000 && lock.sequence() == 2 * 200001;
+
+    // Live pipeline: another thread reads snapshots and exports while a fake session runs.
+    const auto path = (std::filesystem::temp_directory_path() / "sonarlock_test.prom").string();
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 6.0;
+    cfg.scenario = core::FakeScenario::Human;
+    core::BasicDspPipeline p;
+    core::MetricsExporter exporter;
+    ok = ok && exporter.start(p, path, 2).ok();
+    core::RuntimeMetrics final_metrics;
+    done.store(false);
+    std::thread session([&] {
+        ok = audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(cfg, p, final_metrics, [] { return false; }).ok() && ok;
+        done.store(true);
+    });
+    bool live_ok = true;
+    last = 0;
+    while (!done.load()) {
+        const auto m = p.snapshot();
+        live_ok = live_ok && m.callbacks >= last && m.frames_processed == m.callbacks * cfg.audio.frames_per_buffer &&
+                  m.timing.compute_max_us >= 0.0;
+        last = m.callbacks;
+    }
+    session.join();
+    exporter.stop();
+    const auto snap = p.snapshot();
+    ok = ok && live_ok && snap.callbacks == final_metrics.callbacks && snap.triggered_count == final_metrics.triggered_count &&
+         snap.latest_event.score == final_metrics.latest_event.score && exporter.exports() >= 2;
+
+    std::ifstream in(path);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ok = ok && text.find("sonarlock_callbacks_total " + std::to_string(final_metrics.callbacks) + "\n") != std::string::npos &&
+         text.find("# TYPE sonarlock_callback_compute_seconds summary") != std::string::npos &&
+         text.find("sonarlock_callback_stage_seconds{stage=\"journal\"}") != std::string::npos &&
+         !std::filesystem::exists(path + ".tmp");
+    std::filesystem::remove(path);
+    app::CommandLine c;
+    ok = ok && app::parse_args({"run", "--metrics-file", "m.prom", "--metrics-interval-ms", "250"}, c).ok() &&
+         c.config.logging.metrics_path == "m.prom" && c.config.logging.metrics_interval_ms == 250;
+    return ok && !exporter.start(p, "/nonexistent-dir/x.prom", 10).ok();
+}
+
+bool test_time_series_stream() {
+    using namespace sonarlock;
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto bin_path = (dir / "sonarlock_test.slseries").string();
+    const auto csv_path = (dir / "sonarlock_test_series.csv").string();
+    core::AudioConfig cfg;
+    cfg.audio.duration_seconds = 12.0;
+    cfg.scenario = core::FakeScenario::Human;
+
+    core::BasicDspPipeline p;
+    core::SeriesWriter bin, csv;
+    core::SeriesTap bin_tap(p, bin);
+    core::SeriesTap csv_tap(bin_tap, csv);
+    core::FeatureRecorder live;
+    core::FeatureTap live_tap(csv_tap, live);
+    core::RuntimeMetrics m;
+    bool ok = core::series_format_for(csv_path) == core::SeriesFormat::Csv && core::series_format_for(bin_path) == core::SeriesFormat::Binary &&
+              bin.open(bin_path, core::SeriesFormat::Binary, cfg, true).ok() && csv.open(csv_path, core::SeriesFormat::Csv, cfg, true).ok() &&
+              audio::FakeAudioBackend(cfg.scenario, cfg.seed).run_session(cfg, live_tap, m, [] { return false; }).ok() &&
+              bin.close().ok() && csv.close().ok() && bin.dropped_rows() == 0 && csv.dropped_rows() == 0 &&
+              bin.rows_written() == m.callbacks && csv.rows_written() == m.callbacks && m.triggered_count > 0;
+    const auto frames = live.take_frames();
+
+    core::SeriesReader reader;
+    ok = ok && reader.open(bin_path).ok() && reader.rows() == m.callbacks && reader.sample_rate_hz() == cfg.audio.sample_rate_hz;
+    std::uint64_t triggered = 0;
+    for (std::size_t i = 0; ok && i < reader.rows(); ++i) {
+        const auto r = reader.row(i);
+        ok = r.timestamp_sec == frames[i].timestamp_sec &&
+             r.features.relative_motion == static_cast<float>(frames[i].features.relative_motion);
+        if (r.state == core::DetectionState::Triggered) ++triggered;
+    }
+    const auto last = reader.row(reader.rows() - 1);
+    ok = ok && triggered == m.triggered_count && last.state == m.latest_event.state &&
+         last.score == static_cast<float>(m.latest_event.score) && last.trigger_threshold == static_cast<float>(m.trigger_threshold);
+
+    std::ifstream in(csv_path);
+    std::string line, last_line;
+    std::size_t lines = 0, csv_triggered = 0;
+    while (std::getline(in, line)) {
+        ++lines;
+        if (line.find(",TRIGGERED,") != std::string::npos) ++csv_triggered;
+        last_line = line;
+    }
+    ok = ok && lines == m.callbacks + 1 && csv_triggered == m.triggered_count &&
+         std::stod(last_line.substr(0, last_line.find(','))) == m.latest_event.timestamp_sec;
+
+    // A torn final record is dropped.
+    std::filesystem::resize_file(bin_path, std::filesystem::file_size(bin_path) - 10);
+    core::SeriesReader cut;
+    ok = ok && cut.open(bin_path).ok() && cut.rows() == m.callbacks - 1;
+    std::filesystem::remove(bin_path);
+    std::filesystem::remove(csv_path);
+
+    app::CommandLine c;
+    return ok && app::parse_args({"analyze", "--series", "run.csv"}, c).ok() && c.config.logging.series_path == "run.csv";
+}
+
+bool test_scenario_synth_deterministic() {
+    using namespace sonarlock;
+    core::AudioConfig cfg;
+    cfg.audio.input_channels = 3;
+    const std::size_t frames = static_cast<std::size_t>(cfg.audio.sample_rate_hz * 3.0);
+    const std::size_t ch = cfg.audio.input_channels;
+    bool ok = true;
+    for (const auto scenario : {core::FakeScenario::Static, core::FakeScenario::Human, core::FakeScenario::Pet, core::FakeScenario::Vibration}) {
+        // Reference: sequential 256-frame blocks.
+        audio::ScenarioSynth seq(cfg, scenario, 7, 3.0);
+        std::vector<float> ref(frames * ch);
+        for (std::size_t off = 0; off < frames; off += 256) {
+            const std::size_t n = std::min<std::size_t>(256, frames - off);
+            seq.render(off, std::span<float>(ref.data() + off * ch, n * ch));
+        }
+        // Odd-sized blocks, back to front, split over two threads with their own instances.
+        std::vector<float> split(frames * ch);
+        const auto render_range = [&](std::size_t begin, std::size_t end) {
+            audio::ScenarioSynth synth(cfg, scenario, 7, 3.0);
+            for (std::size_t stop = end; stop > begin;) {
+                const std::size_t start = stop > begin + 997 ? stop - 997 : begin;
+                synth.render(start, std::span<float>(split.data() + start * ch, (stop - start) * ch));
+                stop = start;
+            }
+        };
+        std::thread other([&] { render_range(frames / 3, frames); });
+        render_range(0, frames / 3);
+        other.join();
+        ok = ok && std::memcmp(ref.data(), split.data(), ref.size() * sizeof(float)) == 0;
+
+        audio::ScenarioSynth reseeded(cfg, scenario, 8, 3.0);
+        std::vector<float> other_seed(256 * ch);
+        reseeded.render(0, other_seed);
+        ok = ok && std::memcmp(ref.data(), other_seed.data(), other_seed.size() * sizeof(float)) != 0;
+    }
+
+    // Static channel 0 is the 0.25 tone plus noise within +-0.01; the phasors stay on the exact sine.
+    audio::ScenarioSynth tone(cfg, core::FakeScenario::Static, 7, 3.0);
+    std::vector<float> buf(frames * ch);
+    tone.render(0, buf);
+    double max_err = 0.0, noise_sum = 0.0;
+    for (std::size_t n = 0; n < frames; ++n) {
+        const double exact = 0.25 * std::sin(2.0 * std::acos(-1.0) * cfg.audio.f0_hz * static_cast<double>(n) / cfg.audio.sample_rate_hz);
+        max_err = std::max(max_err, std::abs(buf[n * ch] - exact));
+        noise_sum += buf[n * ch] - exact;
+    }
+    ok = ok && max_err <= 0.0100001 && max_err > 0.009 && std::abs(noise_sum / static_cast<double>(frames)) < 1e-3;
+
+    // Human: the echo only appears inside the motion window.
+    audio::ScenarioSynth human(cfg, core::FakeScenario::Human, 7, 3.0);
+    human.render(0, buf);
+    const auto [start, end] = audio::FakeAudioBackend::motion_window(core::FakeScenario::Human, 3.0);
+    float before = 0.0F, inside = 0.0F;
+    for (std::size_t n = 0; n < frames; ++n) {
+        const double t = static_cast<double>(n) / cfg.audio.sample_rate_hz;
+        (t > start && t < end ? inside : before) = std::max(t > start && t < end ? inside : before, std::abs(buf[n * ch]));
+    }
+    return ok && before < 0.26F && inside > 0.6F;
+}
+
+bool test_static_pipeline_matches_basic() {
+    using namespace sonarlock;
+    // Compile-time coefficients agree with the runtime designs.
+    using Default = core::StaticDspPipeline<core::kStaticDspDefault>;
+    using Decimated = core::StaticDspPipeline<core::kStaticDspDecimated>;
+    const auto close = [](const core::BiquadCoeffs& a, const core::BiquadCoeffs& b) {
+        return std::abs(a.b0 - b.b0) < 1e-15 && std::abs(a.b1 - b.b1) < 1e-15 && std::abs(a.b2 - b.b2) < 1e-15 &&
+               std::abs(a.a1 - b.a1) < 1e-15 && std::abs(a.a2 - b.a2) < 1e-15;
+    };
+    bool ok = close(Default::kLowPass, core::design_one_pole_lowpass(48000.0, 500.0)) &&
+              close(Decimated::kBandHighPass, core::design_highpass(1500.0, 20.0)) &&
+              close(Decimated::kBandLowPass, core::design_lowpass(1500.0, 200.0)) &&
+              std::abs(Decimated::kSignalAlpha - (1.0 - std::pow(0.995, 32.0))) < 1e-15;
+
+    // Same input through both pipelines, compared every callback.
+    const auto compare = [](core::AudioConfig cfg, core::IDspPipeline& fixed) {
+        cfg.scenario = core::FakeScenario::Human;
+        cfg.audio.duration_seconds = 12.0;
+        cfg.audio.frames_per_buffer = 200; // not a multiple of the decimation factor
+        const auto frames = static_cast<std::size_t>(cfg.audio.duration_seconds * cfg.audio.sample_rate_hz);
+        audio::ScenarioSynth synth(cfg, cfg.scenario, cfg.seed, cfg.audio.duration_seconds);
+        const std::size_t ch = synth.channels();
+        std::vector<float> input(frames * ch);
+        synth.render(0, input);
+        core::BasicDspPipeline basic;
+        basic.begin_session(cfg);
+        fixed.begin_session(cfg);
+        std::vector<float> out_basic(cfg.audio.frames_per_buffer);
+        std::vector<float> out_fixed(cfg.audio.frames_per_buffer);
+        double worst = 0.0;
+        bool same = true;
+        const auto rel = [](double a, double b) { return std::abs(a - b) / std::max(1e-6, std::abs(a)); };
+        for (std::size_t off = 0; off < frames; off += cfg.audio.frames_per_buffer) {
+            const std::size_t n = std::min(cfg.audio.frames_per_buffer, frames - off);
+            const auto in = std::span<const float>(input).subspan(off * ch, n * ch);
+            basic.process(in, std::span<float>(out_basic).first(n), off);
+            fixed.process(in, std::span<float>(out_fixed).first(n), off);
+            const auto a = basic.latest();
+            const auto b = fixed.latest();
+            for (const auto field : core::kFeatureFields) worst = std::max(worst, rel(a.features.*field, b.features.*field));
+            worst = std::max(worst, rel(a.latest_event.score, b.latest_event.score));
+            same = same && a.latest_event.state == b.latest_event.state && a.dominant_channel == b.dominant_channel &&
+                   out_basic == out_fixed;
+        }
+        const auto a = basic.metrics();
+        const auto b = fixed.metrics();
+        return same && worst < 1e-7 && a.triggered_count == b.triggered_count && a.triggered_count > 0 &&
+               a.callbacks == b.callbacks && fixed.journal()->size() == basic.journal()->size();
+    };
+    core::AudioConfig cfg;
+    core::StaticDspPipeline<core::kStaticDspDefault> mono;
+    ok = ok && compare(cfg, mono);
+    cfg.dsp.filter_design = core::FilterDesign::Butterworth;
+    cfg.dsp.decimation = 32;
+    core::StaticDspPipeline<core::kStaticDspDecimated> decimated;
+    ok = ok && compare(cfg, decimated);
+    // Any spec instantiates, not only the compiled-in ones.
+    cfg = core::AudioConfig{};
+    cfg.audio.input_channels = 3;
+    core::StaticDspPipeline<core::StaticDspSpec{.input_channels = 3}> array;
+    ok = ok && compare(cfg, array);
+
+    // Selection.
+    core::AudioConfig sel;
+    const auto is_basic = [](const std::unique_ptr<core::IDspPipeline>& p) {
+        return dynamic_cast<core::BasicDspPipeline*>(p.get()) != nullptr;
+    };
+    ok = ok && core::has_static_dsp_pipeline(sel) && is_basic(core::make_dsp_pipeline(sel)); // opt-in only
+    sel.dsp.pipeline = core::DspPipelineKind::Static;
+    ok = ok && !is_basic(core::make_dsp_pipeline(sel));
+    sel.dsp.pipeline = core::DspPipelineKind::Auto;
+    ok = ok && !is_basic(core::make_dsp_pipeline(sel));
+
+    // Stages the static pipeline folds together are reported as not timed rather than as zero.
+    {
+        core::AudioConfig run_cfg;
+        run_cfg.audio.duration_seconds = 1.0;
+        core::StaticDspPipeline<core::kStaticDspDefault> fixed;
+        core::RuntimeMetrics m;
+        ok = ok && audio::FakeAudioBackend(run_cfg.scenario, run_cfg.seed).run_session(run_cfg, fixed, m, [] { return false; }).ok();
+        const auto stage = [&](core::DspStage s) { return m.timing.stage_mean_us[static_cast<std::size_t>(s)]; };
+        std::string text;
+        core::append_prometheus(text, m);
+        ok = ok && std::isnan(stage(core::DspStage::Mix)) && std::isnan(stage(core::DspStage::Filter)) &&
+             std::isfinite(stage(core::DspStage::Features)) && std::isfinite(stage(core::DspStage::Detect)) &&
+             text.find("stage=\"mix\"") == std::string::npos && text.find("stage=\"features\"") != std::string::npos;
+    }
+    sel.audio.f0_hz = 18500.0;
+    return ok && !core::has_static_dsp_pipeline(sel) && is_basic(core::make_dsp_pipeline(sel));
+}
+
 } // namespace
 
 int main() {
@@ -105,7 +1362,36 @@ int main() {
         {"anti_lock_loop", test_anti_lock_loop},
         {"platform_executor", test_platform_executor_paths},
         {"cli_phase3", test_cli_parsing_phase3_flags},
+        {"cli_decoupled", test_cli_parsing_decoupled_flags},
         {"integration", test_integration_human_triggers_static_not},
+        {"simd_kernels", test_simd_kernels_match_scalar},
+        {"block_pipeline", test_block_pipeline_matches_scalar_kernels},
+        {"nco_batch", test_nco_batch_modes_bounded},
+        {"sine_generator_span", test_sine_generator_span_matches_reference},
+        {"callback_allocations", test_callback_path_allocation_free},
+        {"spsc_ring", test_spsc_ring_wraps},
+        {"async_runner", test_async_runner_ring_accounting},
+        {"decoupled_offline", test_decoupled_dsp_offline_backends},
+        {"event_journal", test_event_journal_pod_ring},
+        {"async_logger", test_async_logger_rotation},
+        {"streaming_median_mad", test_streaming_median_mad_bound},
+        {"threshold_adaptation", test_online_threshold_adaptation},
+        {"cic_decimator", test_cic_decimator_front_end},
+        {"phase_step", test_phase_step_matches_atan2},
+        {"biquad_cascade", test_biquad_cascade_designs},
+        {"doppler_stft", test_fft_and_doppler_spectrogram},
+        {"multichannel", test_multichannel_fusion_matches_mono},
+        {"batch_engine", test_batch_engine_matches_sequential},
+        {"batch_engine_cancel", test_batch_engine_cancel},
+        {"file_backend", test_file_backend_matches_live},
+        {"capture_recorder", test_capture_recorder_roundtrip},
+        {"parameter_sweep", test_parameter_sweep_matches_live},
+        {"feature_trace", test_feature_trace_replay},
+        {"callback_timing", test_callback_timing},
+        {"metrics_snapshot", test_metrics_snapshot_concurrent},
+        {"time_series", test_time_series_stream},
+        {"scenario_synth", test_scenario_synth_deterministic},
+        {"static_pipeline", test_static_pipeline_matches_basic},
     };
 
     for (const auto& t : tests) {